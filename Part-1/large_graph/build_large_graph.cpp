@@ -1,17 +1,368 @@
 #include <bits/stdc++.h>
+#include <sys/resource.h>
 using namespace std;
 
 struct Edge { int from, to, w; };
 
-int main() {
+const string INPUT_FILE = "roadNet-CA.txt";  // decompressed SNAP file
+const string NODES_FILE = "nodes.csv";
+const string EDGES_FILE = "edges.csv";
+const string GRAPH_FILE = "graph.csv";
+const string HEUR_FILE  = "heuristics.csv";
+const string PERM_FILE  = "permutation.csv";
+const string CSR_OFFSETS_FILE = "csr_offsets.bin";   // --stream only
+const string CSR_EDGES_FILE   = "csr_edges.bin";
+
+// ---------- Node renumbering ----------
+// Each order returns newId[oldId]. Renumbering so that nodes adjacent in the
+// graph (bfs / rcm) or in the plane (hilbert) get nearby ids keeps a search's
+// dist/parent/adjacency accesses within fewer cache lines.
+
+// Undirected CSR over all edges, used by the BFS-based orders.
+static void buildCsr(int N, const vector<Edge>& edges, vector<int>& start, vector<int>& nbr) {
+    start.assign(N + 1, 0);
+    for (auto& e : edges) { start[e.from + 1]++; start[e.to + 1]++; }
+    for (int i = 0; i < N; ++i) start[i + 1] += start[i];
+    nbr.resize(start[N]);
+    vector<int> fill(start.begin(), start.end() - 1);
+    for (auto& e : edges) { nbr[fill[e.from]++] = e.to; nbr[fill[e.to]++] = e.from; }
+}
+
+// Plain BFS (rcm = false) or reverse Cuthill-McKee: each component starts at
+// its lowest-degree node, neighbours are visited in ascending degree, and the
+// final order is reversed.
+static vector<int> bfsOrder(int N, const vector<Edge>& edges, bool rcm) {
+    vector<int> start, nbr;
+    buildCsr(N, edges, start, nbr);
+    auto deg = [&](int v) { return start[v + 1] - start[v]; };
+
+    vector<int> seeds(N);
+    iota(seeds.begin(), seeds.end(), 0);
+    if (rcm) stable_sort(seeds.begin(), seeds.end(), [&](int a, int b) { return deg(a) < deg(b); });
+
+    vector<int> order;
+    order.reserve(N);
+    vector<char> seen(N, 0);
+    vector<int> scratch;
+    for (int s : seeds) {
+        if (seen[s]) continue;
+        seen[s] = 1;
+        size_t head = order.size();
+        order.push_back(s);
+        while (head < order.size()) {
+            int u = order[head++];
+            scratch.assign(nbr.begin() + start[u], nbr.begin() + start[u + 1]);
+            if (rcm) sort(scratch.begin(), scratch.end(), [&](int a, int b) { return deg(a) < deg(b); });
+            for (int v : scratch)
+                if (!seen[v]) { seen[v] = 1; order.push_back(v); }
+        }
+    }
+    if (rcm) reverse(order.begin(), order.end());
+
+    vector<int> newId(N);
+    for (int i = 0; i < N; ++i) newId[order[i]] = i;
+    return newId;
+}
+
+// Distance along a Hilbert curve of side 2^16 for integer cell (x, y).
+static uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+    const uint32_t n = 1u << 16;
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) { x = n - 1 - x; y = n - 1 - y; }
+            swap(x, y);
+        }
+    }
+    return d;
+}
+
+static vector<int> hilbertOrder(const vector<pair<float,float>>& pos) {
+    int N = pos.size();
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (auto& p : pos) {
+        minX = min(minX, p.first); maxX = max(maxX, p.first);
+        minY = min(minY, p.second); maxY = max(maxY, p.second);
+    }
+    float span = max({maxX - minX, maxY - minY, 1e-6f});
+    vector<pair<uint64_t,int>> keyed(N);
+    for (int i = 0; i < N; ++i) {
+        auto q = [&](float v, float lo) { return (uint32_t)min(65535.f, (v - lo) / span * 65535.f); };
+        keyed[i] = {hilbertIndex(q(pos[i].first, minX), q(pos[i].second, minY)), i};
+    }
+    sort(keyed.begin(), keyed.end());
+    vector<int> newId(N);
+    for (int i = 0; i < N; ++i) newId[keyed[i].second] = i;
+    return newId;
+}
+
+// ---------- Streaming build ----------
+// Bounded-memory variant for edge lists that don't fit in RAM: edges are read
+// in chunks of at most --mem-mb, each chunk is sorted by (from, to) and
+// spilled to a binary run file, and the runs are k-way merged straight into
+// edges.csv / graph.csv / the CSR files. Every open run needs a read buffer
+// of at least MIN_RUN_BUFFER edges out of the same cap, so when there are
+// more runs than that allows, groups of them are first merged into longer
+// runs (extra passes over the data) until one final merge fits. A run file
+// that can't be reopened or comes back short is fatal. Node positions and
+// heuristics are regenerated per node while writing, so no per-node array is
+// ever held.
+// The output matches the in-memory build (same weights, positions and
+// heuristics) except that edges come out sorted by source.
+
+static long peakRssKb() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024;
+#else
+    return ru.ru_maxrss;
+#endif
+}
+
+constexpr size_t MIN_RUN_BUFFER = 1024;     // edges per run read buffer
+
+struct Run { string path; size_t edges; };
+
+struct RunReader {
+    FILE* f = nullptr;
+    string path;
+    vector<Edge> buf;
+    size_t pos = 0, len = 0, left = 0;      // left: edges still in the file
+
+    void open(const Run& r, size_t bufEdges) {
+        path = r.path;
+        left = r.edges;
+        f = fopen(path.c_str(), "rb");
+        if (!f) {
+            cerr << "❌ Cannot reopen run file " << path << "\n";
+            exit(1);
+        }
+        buf.resize(bufEdges);
+    }
+
+    bool next(Edge& e) {
+        if (pos == len) {
+            if (left == 0) return false;
+            size_t want = min(left, buf.size());
+            len = fread(buf.data(), sizeof(Edge), want, f);
+            if (len != want) {
+                cerr << "❌ Short read from run file " << path << " (" << left - len << " edges missing)\n";
+                exit(1);
+            }
+            left -= len;
+            pos = 0;
+        }
+        e = buf[pos++];
+        return true;
+    }
+};
+
+// K-way merge of runs in (from, to) order; each run gets an equal share of
+// memBytes as its read buffer. The run files are deleted afterwards.
+template <class Emit>
+static void mergeRuns(const vector<Run>& runs, size_t memBytes, Emit&& emit) {
+    vector<RunReader> readers(runs.size());
+    size_t perRun = max<size_t>(1, memBytes / max<size_t>(1, runs.size()) / sizeof(Edge));
+    using Head = pair<pair<int,int>, size_t>;          // ((from, to), run)
+    priority_queue<Head, vector<Head>, greater<Head>> heads;
+    vector<Edge> current(runs.size());
+    for (size_t r = 0; r < runs.size(); ++r) {
+        readers[r].open(runs[r], perRun);
+        if (readers[r].next(current[r])) heads.push({{current[r].from, current[r].to}, r});
+    }
+    while (!heads.empty()) {
+        size_t r = heads.top().second;
+        heads.pop();
+        const Edge e = current[r];
+        if (readers[r].next(current[r])) heads.push({{current[r].from, current[r].to}, r});
+        emit(e);
+    }
+    for (size_t r = 0; r < runs.size(); ++r) {
+        fclose(readers[r].f);
+        remove(runs[r].path.c_str());
+    }
+}
+
+static int streamBuild(size_t memBytes, const string& tmpDir) {
+    using clk = chrono::steady_clock;
+    auto secs = [](clk::time_point a, clk::time_point b) { return chrono::duration<double>(b - a).count(); };
+    auto t0 = clk::now();
+
+    FILE* fin = fopen(INPUT_FILE.c_str(), "r");
+    if (!fin) {
+        cerr << "❌ Cannot open " << INPUT_FILE << "\n";
+        return 1;
+    }
+
+    // Phase 1: chunked read, sort and spill.
+    const size_t chunkEdges = max<size_t>(1, memBytes / sizeof(Edge));
+    cout << "📖 Streaming edges from " << INPUT_FILE << " (" << memBytes / (1024 * 1024)
+         << " MB cap, " << chunkEdges << " edges per run) ...\n";
+    vector<Edge> chunk;
+    chunk.reserve(chunkEdges);
+    vector<Run> runs;
+    auto spill = [&]() {
+        if (chunk.empty()) return;
+        sort(chunk.begin(), chunk.end(), [](const Edge& a, const Edge& b) {
+            return a.from != b.from ? a.from < b.from : a.to < b.to;
+        });
+        string path = tmpDir + "/build_run_" + to_string(runs.size()) + ".bin";
+        FILE* out = fopen(path.c_str(), "wb");
+        if (!out || fwrite(chunk.data(), sizeof(Edge), chunk.size(), out) != chunk.size()) {
+            cerr << "❌ Cannot write run file " << path << "\n";
+            exit(1);
+        }
+        fclose(out);
+        runs.push_back({path, chunk.size()});
+        chunk.clear();
+    };
+
+    long long maxNode = -1, edgeCount = 0, inputBytes = 0;
+    char line[256];
+    while (fgets(line, sizeof line, fin)) {
+        inputBytes += strlen(line);
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+        char* end;
+        long u = strtol(line, &end, 10);
+        if (end == line) continue;
+        char* p = end;
+        long v = strtol(p, &end, 10);
+        if (end == p) continue;
+        maxNode = max({maxNode, (long long)u, (long long)v});
+        chunk.push_back({(int)u, (int)v, rand() % 20 + 1});
+        edgeCount++;
+        if (chunk.size() == chunkEdges) spill();
+    }
+    fclose(fin);
+    spill();
+    vector<Edge>().swap(chunk);
+    int N = (int)(maxNode + 1);
+    auto t1 = clk::now();
+    cout << "✅ Read " << N << " nodes and " << edgeCount << " edges into " << runs.size() << " sorted runs.\n";
+
+    // Phase 2: nodes.csv and heuristics.csv, one node at a time. The goal is
+    // node 0, whose position is the first one drawn.
+    cout << "🧩 Writing CSV files ...\n";
+    {
+        mt19937_64 rng(12345);
+        uniform_real_distribution<float> xdist(0, 5000), ydist(0, 5000);
+        ofstream nout(NODES_FILE), hout(HEUR_FILE);
+        nout << "id,name,x,y\n";
+        hout << "Node,Heuristic_to_Node0\n";
+        float gx = 0, gy = 0;
+        for (int i = 0; i < N; ++i) {
+            float x = xdist(rng), y = ydist(rng);
+            if (i == 0) { gx = x; gy = y; }
+            float dx = x - gx, dy = y - gy;
+            nout << i << ",Node_" << i << "," << x << "," << y << "\n";
+            hout << "Node_" << i << "," << static_cast<int>(sqrt(dx*dx + dy*dy) / 100.0f + 0.5f) << "\n";
+        }
+    }
+
+    // Phase 3: merge runs in groups of maxFanIn until the rest fit in one
+    // final merge without shrinking a read buffer below MIN_RUN_BUFFER.
+    const size_t maxFanIn = max<size_t>(2, memBytes / sizeof(Edge) / MIN_RUN_BUFFER);
+    for (int pass = 1; runs.size() > maxFanIn; ++pass) {
+        vector<Run> merged;
+        for (size_t i = 0; i < runs.size(); i += maxFanIn) {
+            vector<Run> group(runs.begin() + i, runs.begin() + min(runs.size(), i + maxFanIn));
+            Run out{tmpDir + "/build_run_p" + to_string(pass) + "_" + to_string(merged.size()) + ".bin", 0};
+            FILE* f = fopen(out.path.c_str(), "wb");
+            if (!f) {
+                cerr << "❌ Cannot write run file " << out.path << "\n";
+                exit(1);
+            }
+            mergeRuns(group, memBytes, [&](const Edge& e) {
+                if (fwrite(&e, sizeof e, 1, f) != 1) {
+                    cerr << "❌ Cannot write run file " << out.path << "\n";
+                    exit(1);
+                }
+                out.edges++;
+            });
+            if (fclose(f) != 0) {
+                cerr << "❌ Cannot write run file " << out.path << "\n";
+                exit(1);
+            }
+            merged.push_back(out);
+        }
+        cout << "🔀 Merge pass " << pass << ": " << runs.size() << " runs -> " << merged.size() << "\n";
+        runs = move(merged);
+    }
+
+    ofstream eout(EDGES_FILE), gout(GRAPH_FILE);
+    eout << "from,to,weight,directed\n";
+    gout << "Source,Target,Weight\n";
+    // CSR: offsets are N+1 uint64, edges are (to, weight) int32 pairs, both native-endian.
+    FILE* offOut = fopen(CSR_OFFSETS_FILE.c_str(), "wb");
+    FILE* csrOut = fopen(CSR_EDGES_FILE.c_str(), "wb");
+    if (!offOut || !csrOut) {
+        cerr << "❌ Cannot write CSR files\n";
+        return 1;
+    }
+    uint64_t written = 0;
+    int nextOffset = 0;                                // next node whose offset is due
+    mergeRuns(runs, memBytes, [&](const Edge& e) {
+        for (; nextOffset <= e.from; ++nextOffset) fwrite(&written, sizeof written, 1, offOut);
+        int32_t rec[2] = {e.to, e.w};
+        fwrite(rec, sizeof rec, 1, csrOut);
+        written++;
+        eout << e.from << "," << e.to << "," << e.w << ",1\n";
+        gout << "Node_" << e.from << ",Node_" << e.to << "," << e.w << "\n";
+    });
+    for (; nextOffset <= N; ++nextOffset) fwrite(&written, sizeof written, 1, offOut);
+    fclose(offOut);
+    fclose(csrOut);
+    if ((long long)written != edgeCount) {
+        cerr << "❌ Merged " << written << " of " << edgeCount << " edges\n";
+        return 1;
+    }
+    auto t2 = clk::now();
+
+    double readS = secs(t0, t1), writeS = secs(t1, t2), total = secs(t0, t2);
+    cout << "✅ Done.\n";
+    cout << "   • " << NODES_FILE << "\n";
+    cout << "   • " << EDGES_FILE << "\n";
+    cout << "   • " << GRAPH_FILE << "\n";
+    cout << "   • " << HEUR_FILE  << "\n";
+    cout << "   • " << CSR_OFFSETS_FILE << ", " << CSR_EDGES_FILE << "\n";
+    cout << fixed << setprecision(2);
+    cout << "📊 Read+sort: " << readS << " s (" << edgeCount / max(readS, 1e-9) / 1e6 << " M edges/s, "
+         << inputBytes / max(readS, 1e-9) / (1024 * 1024) << " MB/s)\n";
+    cout << "📊 Merge+write: " << writeS << " s (" << edgeCount / max(writeS, 1e-9) / 1e6 << " M edges/s)\n";
+    cout << "📊 Total: " << total << " s | Peak RSS: " << peakRssKb() / 1024.0 << " MB\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
 
-    const string INPUT_FILE = "roadNet-CA.txt";  // decompressed SNAP file
-    const string NODES_FILE = "nodes.csv";
-    const string EDGES_FILE = "edges.csv";
-    const string GRAPH_FILE = "graph.csv";
-    const string HEUR_FILE  = "heuristics.csv";
+    // --order none|bfs|rcm|hilbert renumbers nodes before writing.
+    // --stream [--mem-mb N] [--tmp DIR] builds with bounded memory (no renumbering).
+    string order = "none", tmpDir = ".";
+    bool stream = false;
+    size_t memMb = 256;
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a == "--stream") stream = true;
+        else if (a == "--order" && i + 1 < argc) order = argv[++i];
+        else if (a == "--mem-mb" && i + 1 < argc) memMb = max(1, atoi(argv[++i]));
+        else if (a == "--tmp" && i + 1 < argc) tmpDir = argv[++i];
+    }
+    if (order != "none" && order != "bfs" && order != "rcm" && order != "hilbert") {
+        cerr << "❌ Unknown --order " << order << " (none|bfs|rcm|hilbert)\n";
+        return 1;
+    }
+    if (stream) {
+        if (order != "none") {
+            cerr << "❌ --order needs the whole graph in memory; it can't be combined with --stream\n";
+            return 1;
+        }
+        return streamBuild(memMb * 1024 * 1024, tmpDir);
+    }
 
     ifstream fin(INPUT_FILE);
     if (!fin.is_open()) {
@@ -52,6 +403,29 @@ int main() {
         heur[i] = static_cast<int>(sqrt(dx*dx + dy*dy) / 100.0f + 0.5f);
     }
 
+    // Renumber nodes, then rewrite edges, positions and heuristics together so
+    // every file agrees. permutation.csv maps the new ids back to SNAP ids.
+    if (order != "none") {
+        cout << "🔀 Renumbering nodes (" << order << ") ...\n";
+        vector<int> newId = (order == "hilbert") ? hilbertOrder(pos) : bfsOrder(N, edges, order == "rcm");
+        vector<pair<float,float>> pos2(N);
+        vector<int> heur2(N);
+        for (int i = 0; i < N; ++i) { pos2[newId[i]] = pos[i]; heur2[newId[i]] = heur[i]; }
+        pos.swap(pos2);
+        heur.swap(heur2);
+        for (auto& e : edges) { e.from = newId[e.from]; e.to = newId[e.to]; }
+        sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+            return a.from != b.from ? a.from < b.from : a.to < b.to;
+        });
+        goal = newId[goal];
+
+        ofstream pout(PERM_FILE);
+        pout << "new_id,original_id\n";
+        vector<int> oldId(N);
+        for (int i = 0; i < N; ++i) oldId[newId[i]] = i;
+        for (int i = 0; i < N; ++i) pout << i << "," << oldId[i] << "\n";
+    }
+
     cout << "🧩 Writing CSV files ...\n";
 
     // nodes.csv
@@ -74,7 +448,7 @@ int main() {
 
     // heuristics.csv
     ofstream hout(HEUR_FILE);
-    hout << "Node,Heuristic_to_Node0\n";
+    hout << "Node,Heuristic_to_Node" << goal << "\n";
     for (int i = 0; i < N; ++i)
         hout << "Node_" << i << "," << heur[i] << "\n";
 
@@ -83,4 +457,5 @@ int main() {
     cout << "   • " << EDGES_FILE << "\n";
     cout << "   • " << GRAPH_FILE << "\n";
     cout << "   • " << HEUR_FILE  << "\n";
+    if (order != "none") cout << "   • " << PERM_FILE << "\n";
 }
@@ -0,0 +1,347 @@
+#include <bits/stdc++.h>
+#include <sys/resource.h>
+using namespace std;
+
+// Synthetic road-style graphs for load testing, written in the same
+// nodes.csv / edges.csv / heuristics.csv formats as build_large_graph.
+//
+//   gen_synthetic_graph [--model grid|road|geometric] [--nodes N] [--width W]
+//                       [--seed S] [--spacing D] [--detour F] [--keep P]
+//                       [--jitter J] [--degree K] [--goal G]
+//
+//   grid       4-connected lattice (optionally jittered / thinned)
+//   road       jittered lattice triangulated Delaunay-style (shorter diagonal
+//              of every quad), thinned to road-like degree; a random spanning
+//              tree is always kept, so the graph stays connected
+//   geometric  random geometric graph: uniform points, edges between every
+//              pair closer than the radius giving average degree K
+//
+// Every edge weight is its Euclidean length times a random detour factor in
+// [1, 1 + F], rounded up, so weight >= length and the straight-line distance
+// written to heuristics.csv is an admissible (and consistent) A* heuristic.
+// Positions, weights and edge choices come from a counter-based hash of
+// (seed, id), not from a sequential RNG: any node's position can be
+// recomputed on demand, nothing per node is kept in memory, and the same
+// seed always gives byte-identical files.
+
+const string NODES_FILE = "nodes.csv";
+const string EDGES_FILE = "edges.csv";
+const string HEUR_FILE  = "heuristics.csv";
+
+// ---------- Counter-based randomness ----------
+static inline uint64_t mix64(uint64_t z) {                // splitmix64 finalizer
+    z += 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+enum Tag : uint64_t { TAG_X = 1, TAG_Y, TAG_WEIGHT, TAG_KEEP, TAG_TREE };
+
+// Uniform in [0, 1), a pure function of its arguments.
+static inline double unit(uint64_t seed, Tag tag, uint64_t a, uint64_t b = 0) {
+    return (mix64(mix64(mix64(seed ^ (tag * 0xd1b54a32d192ed03ull)) ^ a) ^ b) >> 11) * 0x1.0p-53;
+}
+
+// Coordinates are snapped to the 0.01 grid that nodes.csv is printed with, so
+// weights and heuristics are computed from exactly the values readers load.
+static inline double snap(double v) { return round(v * 100.0) / 100.0; }
+
+// ---------- Buffered CSV output ----------
+struct CsvWriter {
+    FILE* f;
+    vector<char> buf = vector<char>(1 << 20);
+    size_t n = 0;
+    uint64_t bytes = 0;
+    bool ok;
+
+    explicit CsvWriter(const string& path) : f(fopen(path.c_str(), "wb")), ok(f != nullptr) {}
+    ~CsvWriter() { close(); }
+
+    void flush() {
+        if (f && n && fwrite(buf.data(), 1, n, f) != n) ok = false;
+        bytes += n;
+        n = 0;
+    }
+    void close() {
+        if (!f) return;
+        flush();
+        if (fclose(f) != 0) ok = false;
+        f = nullptr;
+    }
+    void put(char c) {
+        if (n == buf.size()) flush();
+        buf[n++] = c;
+    }
+    void put(const string& s) { for (char c : s) put(c); }
+    void putInt(long long v) {
+        char tmp[24];
+        int k = 0;
+        bool neg = v < 0;
+        unsigned long long u = neg ? 0ull - (unsigned long long)v : (unsigned long long)v;
+        do { tmp[k++] = char('0' + u % 10); u /= 10; } while (u);
+        if (neg) put('-');
+        while (k) put(tmp[--k]);
+    }
+    // v is already on the 0.01 grid
+    void putFixed2(double v) {
+        long long cents = llround(v * 100.0);
+        if (cents < 0) { put('-'); cents = -cents; }
+        putInt(cents / 100);
+        put('.');
+        put(char('0' + cents / 10 % 10));
+        put(char('0' + cents % 10));
+    }
+};
+
+// ---------- Models ----------
+struct Generator {
+    string model = "road";
+    long long N = 1000000;
+    long long W = 0, H = 0;       // lattice models
+    uint64_t seed = 1;
+    double spacing = 10.0;        // mean distance between neighbouring nodes
+    double detour = 0.3;
+    double keep = -1;             // < 0: model default
+    double jitter = -1;
+    double degree = 6.0;          // geometric only
+
+    // geometric: the square is cut into cellsX^2 cells no narrower than the
+    // radius, node ids run cell by cell, and every cell holds base or base + 1
+    // nodes, so id -> cell is arithmetic. Cells hold ~16 nodes: with only one
+    // or two per cell the fixed counts would visibly thin out close pairs.
+    double radius = 0, cellSize = 0;
+    long long cellsX = 0, base = 0, extra = 0;
+
+    bool setup(long long width) {
+        if (model == "grid" || model == "road") {
+            if (keep < 0) keep = model == "grid" ? 1.0 : 0.5;
+            if (jitter < 0) jitter = model == "grid" ? 0.0 : 0.35;
+            W = width > 0 ? width : max(2LL, (long long)llround(sqrt((double)N)));
+            H = max(2LL, (N + W - 1) / W);
+            N = W * H;
+        } else if (model == "geometric") {
+            double side = sqrt((double)N) * spacing;
+            radius = spacing * sqrt(degree / M_PI);
+            cellsX = max(1LL, (long long)floor(side / max(radius, 4 * spacing)));
+            cellSize = side / cellsX;
+            long long cells = cellsX * cellsX;
+            base = N / cells;
+            extra = N % cells;
+        } else {
+            return false;
+        }
+        return N > 0 && N <= INT_MAX;
+    }
+
+    long long cellStart(long long k) const { return k * base + min(k, extra); }
+    long long cellOf(long long id) const {
+        long long big = extra * (base + 1);
+        return id < big ? id / (base + 1) : extra + (id - big) / base;
+    }
+
+    pair<double,double> position(long long id) const {
+        double ux = unit(seed, TAG_X, id), uy = unit(seed, TAG_Y, id);
+        if (model == "geometric") {
+            long long k = cellOf(id);
+            return {snap((k % cellsX + ux) * cellSize), snap((k / cellsX + uy) * cellSize)};
+        }
+        long long r = id / W, c = id % W;
+        return {snap((c + jitter * (2 * ux - 1)) * spacing), snap((r + jitter * (2 * uy - 1)) * spacing)};
+    }
+
+    int weight(long long u, long long v) const {
+        auto [ux, uy] = position(u);
+        auto [vx, vy] = position(v);
+        double len = hypot(ux - vx, uy - vy);
+        double f = 1.0 + detour * unit(seed, TAG_WEIGHT, min(u, v), max(u, v));
+        return max(1, (int)ceil(len * f));
+    }
+
+    // Lattice node (r, c) with r + c > 0 hangs off its upper or left
+    // neighbour; together those links form a spanning tree.
+    bool treeUp(long long r, long long c) const {
+        if (r == 0) return false;
+        if (c == 0) return true;
+        return unit(seed, TAG_TREE, r * W + c) < 0.5;
+    }
+    bool kept(long long u, long long v, bool tree) const {
+        return tree || keep >= 1.0 || unit(seed, TAG_KEEP, min(u, v), max(u, v)) < keep;
+    }
+
+    // Calls emit(u, v, w) once per undirected edge.
+    template <class Emit>
+    void edges(Emit&& emit) const {
+        if (model == "geometric") {
+            const double r2 = radius * radius;
+            vector<pair<double,double>> a, b;   // positions of the two cells being linked
+            auto load = [&](vector<pair<double,double>>& out, long long lo, long long hi) {
+                out.clear();
+                for (long long v = lo; v < hi; ++v) out.push_back(position(v));
+            };
+            auto link = [&](long long a0, long long b0, const vector<pair<double,double>>& bp, bool same) {
+                for (size_t i = 0; i < a.size(); ++i)
+                    for (size_t j = same ? i + 1 : 0; j < bp.size(); ++j) {
+                        double dx = a[i].first - bp[j].first, dy = a[i].second - bp[j].second;
+                        if (dx * dx + dy * dy <= r2) emit(a0 + (long long)i, b0 + (long long)j, weight(a0 + i, b0 + j));
+                    }
+            };
+            for (long long cy = 0; cy < cellsX; ++cy)
+                for (long long cx = 0; cx < cellsX; ++cx) {
+                    long long k = cy * cellsX + cx;
+                    long long a0 = cellStart(k), a1 = cellStart(k + 1);
+                    load(a, a0, a1);
+                    link(a0, a0, a, true);
+                    // each unordered cell pair once: E, then the three cells below
+                    const int nx[4] = {1, -1, 0, 1}, ny[4] = {0, 1, 1, 1};
+                    for (int d = 0; d < 4; ++d) {
+                        long long x = cx + nx[d], y = cy + ny[d];
+                        if (x < 0 || x >= cellsX || y >= cellsX) continue;
+                        long long j = y * cellsX + x;
+                        load(b, cellStart(j), cellStart(j + 1));
+                        link(a0, cellStart(j), b, false);
+                    }
+                }
+            return;
+        }
+
+        const bool tri = model == "road";
+        for (long long r = 0; r < H; ++r)
+            for (long long c = 0; c < W; ++c) {
+                long long u = r * W + c;
+                if (c + 1 < W && kept(u, u + 1, !treeUp(r, c + 1))) emit(u, u + 1, weight(u, u + 1));
+                if (r + 1 < H && kept(u, u + W, treeUp(r + 1, c))) emit(u, u + W, weight(u, u + W));
+                if (tri && r + 1 < H && c + 1 < W) {
+                    // Delaunay flip rule on the quad: keep the shorter diagonal.
+                    auto p = [&](long long id) { return position(id); };
+                    auto d2 = [](pair<double,double> a, pair<double,double> b) {
+                        return (a.first - b.first) * (a.first - b.first) + (a.second - b.second) * (a.second - b.second);
+                    };
+                    long long a = u, b = u + 1, d = u + W, e = u + W + 1;
+                    if (d2(p(a), p(e)) <= d2(p(b), p(d))) {
+                        if (kept(a, e, false)) emit(a, e, weight(a, e));
+                    } else if (kept(b, d, false)) {
+                        emit(b, d, weight(b, d));
+                    }
+                }
+            }
+    }
+};
+
+static long peakRssKb() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024;
+#else
+    return ru.ru_maxrss;
+#endif
+}
+
+int main(int argc, char** argv) {
+    Generator gen;
+    long long width = 0, goal = 0;
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        auto next = [&]() { return i + 1 < argc ? string(argv[++i]) : string(); };
+        if (a == "--model") gen.model = next();
+        else if (a == "--nodes") gen.N = atoll(next().c_str());
+        else if (a == "--width") width = atoll(next().c_str());
+        else if (a == "--seed") gen.seed = strtoull(next().c_str(), nullptr, 10);
+        else if (a == "--spacing") gen.spacing = atof(next().c_str());
+        else if (a == "--detour") gen.detour = max(0.0, atof(next().c_str()));
+        else if (a == "--keep") gen.keep = atof(next().c_str());
+        else if (a == "--jitter") gen.jitter = min(0.49, max(0.0, atof(next().c_str())));
+        else if (a == "--degree") gen.degree = atof(next().c_str());
+        else if (a == "--goal") goal = atoll(next().c_str());
+        else {
+            cerr << "❌ Unknown argument " << a << "\n";
+            return 1;
+        }
+    }
+    if (!gen.setup(width)) {
+        cerr << "❌ Bad --model " << gen.model << " (grid|road|geometric) or node count\n";
+        return 1;
+    }
+    if (goal < 0 || goal >= gen.N) {
+        cerr << "❌ --goal must be in [0, " << gen.N << ")\n";
+        return 1;
+    }
+
+    using clk = chrono::steady_clock;
+    auto t0 = clk::now();
+    cout << "🧩 Generating " << gen.model << " graph: " << gen.N << " nodes, seed " << gen.seed << " ...\n";
+
+    // nodes.csv and heuristics.csv, one node at a time.
+    uint64_t nodeBytes = 0;
+    bool ok = true;
+    {
+        CsvWriter nout(NODES_FILE), hout(HEUR_FILE);
+        nout.put("id,name,x,y\n");
+        hout.put("Node,Heuristic_to_Node");
+        hout.putInt(goal);
+        hout.put('\n');
+        auto [gx, gy] = gen.position(goal);
+        for (long long i = 0; i < gen.N; ++i) {
+            auto [x, y] = gen.position(i);
+            nout.putInt(i);
+            nout.put(",Node_");
+            nout.putInt(i);
+            nout.put(',');
+            nout.putFixed2(x);
+            nout.put(',');
+            nout.putFixed2(y);
+            nout.put('\n');
+            hout.put("Node_");
+            hout.putInt(i);
+            hout.put(',');
+            hout.putFixed2(floor(hypot(x - gx, y - gy) * 100.0) / 100.0);   // rounded down: stays admissible
+            hout.put('\n');
+        }
+        nout.close();
+        hout.close();
+        ok = nout.ok && hout.ok;
+        nodeBytes = nout.bytes + hout.bytes;
+    }
+    auto t1 = clk::now();
+
+    // edges.csv: each undirected edge once, directed = 0.
+    long long edgeCount = 0;
+    uint64_t edgeBytes = 0;
+    double weightSum = 0;
+    {
+        CsvWriter eout(EDGES_FILE);
+        eout.put("from,to,weight,directed\n");
+        gen.edges([&](long long u, long long v, int w) {
+            eout.putInt(u);
+            eout.put(',');
+            eout.putInt(v);
+            eout.put(',');
+            eout.putInt(w);
+            eout.put(",0\n");
+            edgeCount++;
+            weightSum += w;
+        });
+        eout.close();
+        ok = ok && eout.ok;
+        edgeBytes = eout.bytes;
+    }
+    auto t2 = clk::now();
+    if (!ok) {
+        cerr << "❌ Write failed (disk full?)\n";
+        return 1;
+    }
+
+    auto secs = [](clk::time_point a, clk::time_point b) { return chrono::duration<double>(b - a).count(); };
+    double nodeS = secs(t0, t1), edgeS = secs(t1, t2);
+    cout << "✅ Done.\n";
+    cout << "   • " << NODES_FILE << ", " << HEUR_FILE << " (goal Node_" << goal << ")\n";
+    cout << "   • " << EDGES_FILE << "\n";
+    cout << fixed << setprecision(2);
+    cout << "📊 " << gen.N << " nodes, " << edgeCount << " undirected edges, average degree "
+         << 2.0 * edgeCount / gen.N << ", mean weight " << weightSum / max(1LL, edgeCount) << "\n";
+    cout << "📊 Nodes: " << nodeS << " s (" << nodeBytes / max(nodeS, 1e-9) / (1024 * 1024) << " MB/s) | Edges: "
+         << edgeS << " s (" << edgeCount / max(edgeS, 1e-9) / 1e6 << " M edges/s, "
+         << edgeBytes / max(edgeS, 1e-9) / (1024 * 1024) << " MB/s)\n";
+    cout << "📊 Peak RSS: " << peakRssKb() / 1024.0 << " MB\n";
+}
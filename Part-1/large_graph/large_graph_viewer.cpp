@@ -0,0 +1,410 @@
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Viewer for the nodes.csv / edges.csv written by build_large_graph.
+// Nodes are bucketed into a uniform grid so only cells that intersect the
+// view are touched; zoomed out, a pyramid of per-cell counts is drawn as
+// density tiles instead of individual nodes.
+
+struct Edge { int u, v; };
+
+constexpr unsigned WIN_W = 1600, WIN_H = 900;
+constexpr int NODES_PER_CELL = 4;          // target occupancy of the finest grid level
+constexpr size_t NODE_BUDGET = 150000;     // max nodes drawn individually
+constexpr size_t EDGE_BUDGET = 200000;     // max edges drawn per frame rebuild
+constexpr size_t LABEL_BUDGET = 150;       // ids are only drawn when this few nodes are in view
+constexpr float MIN_TILE_PX = 4.f;         // smallest density tile on screen
+
+// --- FAST CSV LOADING (2M+ lines, so no stringstream) ---
+static bool loadNodes(const string& file, vector<sf::Vector2f>& pos) {
+    FILE* f = fopen(file.c_str(), "r");
+    if (!f) return false;
+    char line[512];
+    if (!fgets(line, sizeof line, f)) { fclose(f); return false; }  // skip header
+    while (fgets(line, sizeof line, f)) {
+        char* p = line;
+        char* end;
+        long id = strtol(p, &end, 10);
+        if (end == p || *end != ',') continue;
+        p = strchr(end + 1, ',');              // skip name
+        if (!p) continue;
+        float x = strtof(p + 1, &end);
+        if (*end != ',') continue;
+        float y = strtof(end + 1, nullptr);
+        if ((long)pos.size() <= id) pos.resize(id + 1);
+        pos[id] = {x, y};
+    }
+    fclose(f);
+    return true;
+}
+
+static bool loadEdges(const string& file, vector<Edge>& E) {
+    FILE* f = fopen(file.c_str(), "r");
+    if (!f) return false;
+    char line[256];
+    if (!fgets(line, sizeof line, f)) { fclose(f); return false; }  // skip header
+    while (fgets(line, sizeof line, f)) {
+        char* end;
+        long u = strtol(line, &end, 10);
+        if (end == line || *end != ',') continue;
+        long v = strtol(end + 1, &end, 10);
+        E.push_back({(int)u, (int)v});
+    }
+    fclose(f);
+    return true;
+}
+
+// --- SPATIAL INDEX ---
+// Uniform grid in CSR form: nodes are stored contiguously per cell. Level 0
+// of `density` mirrors the grid; every level above it sums 2x2 blocks of the
+// one below. Each edge is filed on the finest level whose cells are at least
+// as long as the edge, in every cell of its bounding box there (at most 2x2),
+// so an edge crossing the view is found even when both endpoints are outside.
+struct GridIndex {
+    float minX = 0, minY = 0, cell = 1;
+    int cols = 1, rows = 1;
+    vector<int> nodeStart, cellNodes;
+    vector<vector<int>> edgeStart, cellEdges;   // per level
+    vector<vector<int>> density;
+    vector<int> levelCols, levelRows;
+
+    int cellX(float x) const { return clamp((int)((x - minX) / cell), 0, cols - 1); }
+    int cellY(float y) const { return clamp((int)((y - minY) / cell), 0, rows - 1); }
+
+    void build(const vector<sf::Vector2f>& pos, const vector<Edge>& E) {
+        float maxX = -INFINITY, maxY = -INFINITY;
+        minX = minY = INFINITY;
+        for (auto& p : pos) {
+            minX = min(minX, p.x); minY = min(minY, p.y);
+            maxX = max(maxX, p.x); maxY = max(maxY, p.y);
+        }
+        if (pos.empty()) minX = minY = maxX = maxY = 0;
+        float w = max(maxX - minX, 1.f), h = max(maxY - minY, 1.f);
+        size_t cells = max<size_t>(1, pos.size() / NODES_PER_CELL);
+        cell = sqrt(w * h / cells);
+        cols = (int)ceil(w / cell) + 1;
+        rows = (int)ceil(h / cell) + 1;
+
+        nodeStart.assign((size_t)cols * rows + 1, 0);
+        auto nodeCell = [&](size_t i) { return cellY(pos[i].y) * cols + cellX(pos[i].x); };
+        for (size_t i = 0; i < pos.size(); ++i) nodeStart[nodeCell(i) + 1]++;
+        for (size_t c = 0; c < (size_t)cols * rows; ++c) nodeStart[c + 1] += nodeStart[c];
+        cellNodes.resize(pos.size());
+        vector<int> fill(nodeStart.begin(), nodeStart.end() - 1);
+        for (size_t i = 0; i < pos.size(); ++i) cellNodes[fill[nodeCell(i)]++] = (int)i;
+
+        density.clear(); levelCols.clear(); levelRows.clear();
+        density.emplace_back((size_t)cols * rows);
+        for (int c = 0; c < cols * rows; ++c) density[0][c] = nodeStart[c + 1] - nodeStart[c];
+        levelCols.push_back(cols); levelRows.push_back(rows);
+        while (levelCols.back() > 1 || levelRows.back() > 1) {
+            int pc = levelCols.back(), pr = levelRows.back();
+            int nc = (pc + 1) / 2, nr = (pr + 1) / 2;
+            vector<int> next((size_t)nc * nr, 0);
+            const vector<int>& prev = density.back();
+            for (int r = 0; r < pr; ++r)
+                for (int c = 0; c < pc; ++c)
+                    next[(r / 2) * nc + c / 2] += prev[r * pc + c];
+            density.push_back(move(next));
+            levelCols.push_back(nc); levelRows.push_back(nr);
+        }
+
+        bucketEdges(pos, E);
+    }
+
+    void bucketEdges(const vector<sf::Vector2f>& pos, const vector<Edge>& E) {
+        int levels = (int)density.size();
+        // Level-0 bounding box of every edge and the level it is filed on.
+        struct Box { int c0, r0, c1, r1, level; };
+        vector<Box> box(E.size(), Box{0, 0, -1, -1, -1});
+        for (size_t i = 0; i < E.size(); ++i) {
+            const Edge& e = E[i];
+            if (e.u < 0 || e.v < 0 || (size_t)e.u >= pos.size() || (size_t)e.v >= pos.size()) continue;
+            int cu = cellX(pos[e.u].x), ru = cellY(pos[e.u].y);
+            int cv = cellX(pos[e.v].x), rv = cellY(pos[e.v].y);
+            Box b{min(cu, cv), min(ru, rv), max(cu, cv), max(ru, rv), 0};
+            while (b.level + 1 < levels &&
+                   ((b.c1 >> b.level) - (b.c0 >> b.level) > 1 || (b.r1 >> b.level) - (b.r0 >> b.level) > 1))
+                ++b.level;
+            box[i] = b;
+        }
+
+        edgeStart.assign(levels, {});
+        cellEdges.assign(levels, {});
+        for (int l = 0; l < levels; ++l)
+            edgeStart[l].assign((size_t)levelCols[l] * levelRows[l] + 1, 0);
+        auto forCells = [&](const Box& b, auto fn) {
+            int L = b.level;
+            for (int r = b.r0 >> L; r <= b.r1 >> L; ++r)
+                for (int c = b.c0 >> L; c <= b.c1 >> L; ++c) fn(L, r * levelCols[L] + c);
+        };
+        for (const Box& b : box)
+            if (b.level >= 0) forCells(b, [&](int L, int c) { edgeStart[L][c + 1]++; });
+        vector<vector<int>> fill(levels);
+        for (int l = 0; l < levels; ++l) {
+            vector<int>& start = edgeStart[l];
+            for (size_t c = 0; c + 1 < start.size(); ++c) start[c + 1] += start[c];
+            cellEdges[l].resize(start.back());
+            fill[l].assign(start.begin(), start.end() - 1);
+        }
+        for (size_t i = 0; i < box.size(); ++i)
+            if (box[i].level >= 0)
+                forCells(box[i], [&](int L, int c) { cellEdges[L][fill[L][c]++] = (int)i; });
+    }
+
+    float levelCell(int level) const { return cell * float(1 << level); }
+};
+
+// --- DENSITY COLOR RAMP (log scale, dark blue -> yellow) ---
+static sf::Color densityColor(int count, int maxCount) {
+    if (count <= 0) return sf::Color(235, 245, 255);
+    float t = log1p((float)count) / log1p((float)max(maxCount, 1));
+    auto lerp = [](float a, float b, float s) { return (uint8_t)(a + (b - a) * s); };
+    return sf::Color(lerp(20, 255, t), lerp(40, 220, t), lerp(140, 30, t));
+}
+
+static void appendQuad(sf::VertexArray& va, sf::Vector2f p, sf::Vector2f s, sf::Color col) {
+    sf::Vector2f a = p, b = {p.x + s.x, p.y}, c = p + s, d = {p.x, p.y + s.y};
+    va.append({a, col}); va.append({b, col}); va.append({c, col});
+    va.append({a, col}); va.append({c, col}); va.append({d, col});
+}
+
+// --- VISIBLE GEOMETRY ---
+// Rebuilt only when the view changes; idle frames redraw the cached arrays.
+struct Scene {
+    sf::VertexArray tiles{sf::PrimitiveType::Triangles};
+    sf::VertexArray lines{sf::PrimitiveType::Lines};
+    sf::VertexArray points{sf::PrimitiveType::Triangles};
+    vector<int> labelled;
+    vector<uint32_t> edgeSeen;     // stamp per edge: an edge can sit in several cells
+    uint32_t stamp = 0;
+    bool densityMode = false;
+    size_t drawnNodes = 0, drawnEdges = 0;
+};
+
+static void rebuildScene(Scene& sc, const GridIndex& gi, const vector<sf::Vector2f>& pos,
+                         const vector<Edge>& E, const sf::View& view, sf::Vector2u winSize) {
+    sc.tiles.clear(); sc.lines.clear(); sc.points.clear(); sc.labelled.clear();
+    sc.drawnNodes = sc.drawnEdges = 0;
+
+    sf::Vector2f vc = view.getCenter(), vs = view.getSize();
+    float x0 = vc.x - vs.x / 2, y0 = vc.y - vs.y / 2, x1 = x0 + vs.x, y1 = y0 + vs.y;
+    float pxPerWorld = winSize.x / vs.x;
+
+    // Coarsest level whose tiles are still at least MIN_TILE_PX wide.
+    int level = 0;
+    while (level + 1 < (int)gi.density.size() && gi.levelCell(level) * pxPerWorld < MIN_TILE_PX)
+        ++level;
+    auto range = [&](int lvl, int& c0, int& r0, int& c1, int& r1) {
+        float cs = gi.levelCell(lvl);
+        c0 = max(0, (int)floor((x0 - gi.minX) / cs));
+        r0 = max(0, (int)floor((y0 - gi.minY) / cs));
+        c1 = min(gi.levelCols[lvl] - 1, (int)floor((x1 - gi.minX) / cs));
+        r1 = min(gi.levelRows[lvl] - 1, (int)floor((y1 - gi.minY) / cs));
+    };
+
+    int c0, r0, c1, r1;
+    range(level, c0, r0, c1, r1);
+    size_t inView = 0;
+    int maxCount = 1;
+    const vector<int>& dens = gi.density[level];
+    for (int r = r0; r <= r1; ++r)
+        for (int c = c0; c <= c1; ++c) {
+            int n = dens[r * gi.levelCols[level] + c];
+            inView += n;
+            maxCount = max(maxCount, n);
+        }
+
+    sc.densityMode = inView > NODE_BUDGET;
+    if (sc.densityMode) {
+        float cs = gi.levelCell(level);
+        for (int r = r0; r <= r1; ++r)
+            for (int c = c0; c <= c1; ++c) {
+                int n = dens[r * gi.levelCols[level] + c];
+                if (n == 0) continue;
+                appendQuad(sc.tiles, {gi.minX + c * cs, gi.minY + r * cs}, {cs, cs},
+                           densityColor(n, maxCount));
+            }
+        return;
+    }
+
+    // Individual nodes: walk only the finest cells in view.
+    range(0, c0, r0, c1, r1);
+    float dot = 3.f / pxPerWorld;                    // 3 px squares regardless of zoom
+    for (int r = r0; r <= r1; ++r)
+        for (int c = c0; c <= c1; ++c) {
+            int cellId = r * gi.cols + c;
+            for (int k = gi.nodeStart[cellId]; k < gi.nodeStart[cellId + 1]; ++k) {
+                int v = gi.cellNodes[k];
+                const sf::Vector2f& p = pos[v];
+                if (p.x < x0 || p.x > x1 || p.y < y0 || p.y > y1) continue;
+                appendQuad(sc.points, {p.x - dot / 2, p.y - dot / 2}, {dot, dot}, sf::Color(0, 160, 200));
+                if (sc.labelled.size() < LABEL_BUDGET) sc.labelled.push_back(v);
+                sc.drawnNodes++;
+            }
+        }
+    if (sc.drawnNodes > LABEL_BUDGET) sc.labelled.clear();
+
+    // Edges: every level, since long edges are filed on coarse ones.
+    if (sc.edgeSeen.size() != E.size() || ++sc.stamp == 0) {
+        sc.edgeSeen.assign(E.size(), 0);
+        sc.stamp = 1;
+    }
+    for (int lvl = 0; lvl < (int)gi.edgeStart.size() && sc.drawnEdges < EDGE_BUDGET; ++lvl) {
+        range(lvl, c0, r0, c1, r1);
+        const vector<int>& start = gi.edgeStart[lvl];
+        for (int r = r0; r <= r1; ++r)
+            for (int c = c0; c <= c1; ++c) {
+                int cellId = r * gi.levelCols[lvl] + c;
+                for (int k = start[cellId]; k < start[cellId + 1] && sc.drawnEdges < EDGE_BUDGET; ++k) {
+                    int ei = gi.cellEdges[lvl][k];
+                    if (sc.edgeSeen[ei] == sc.stamp) continue;
+                    sc.edgeSeen[ei] = sc.stamp;
+                    const Edge& e = E[ei];
+                    sc.lines.append({pos[e.u], sf::Color(90, 90, 220, 140)});
+                    sc.lines.append({pos[e.v], sf::Color(90, 90, 220, 140)});
+                    sc.drawnEdges++;
+                }
+            }
+    }
+}
+
+// --- FONT LOADING ---
+static sf::Font loadFont() {
+    sf::Font font;
+    const char* paths[] = {
+        "/System/Library/Fonts/Supplemental/Arial.ttf",
+        "/System/Library/Fonts/Supplemental/Helvetica.ttc",
+        "/Library/Fonts/Arial.ttf",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"
+    };
+    for (auto p : paths)
+        if (font.openFromFile(p)) return font;
+    cerr << "⚠️ Font not found, labels will be blank.\n";
+    return font;
+}
+
+int main(int argc, char** argv) {
+    const string NODES_FILE = argc > 1 ? argv[1] : "nodes.csv";
+    const string EDGES_FILE = argc > 2 ? argv[2] : "edges.csv";
+
+    auto t0 = chrono::steady_clock::now();
+    vector<sf::Vector2f> pos;
+    vector<Edge> E;
+    if (!loadNodes(NODES_FILE, pos)) { cerr << "❌ Cannot open " << NODES_FILE << "\n"; return 1; }
+    if (!loadEdges(EDGES_FILE, E))   cerr << "⚠️ Cannot open " << EDGES_FILE << ", drawing nodes only.\n";
+    E.erase(remove_if(E.begin(), E.end(), [&](const Edge& e) {
+        return e.u < 0 || e.v < 0 || (size_t)e.u >= pos.size() || (size_t)e.v >= pos.size();
+    }), E.end());
+
+    GridIndex gi;
+    gi.build(pos, E);
+    auto t1 = chrono::steady_clock::now();
+    cout << "✅ Loaded " << pos.size() << " nodes, " << E.size() << " edges; grid "
+         << gi.cols << "x" << gi.rows << " (" << gi.density.size() << " levels) in "
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+
+    sf::RenderWindow window(sf::VideoMode({WIN_W, WIN_H}), "Large Graph Viewer");
+    window.setFramerateLimit(60);
+    sf::Font font = loadFont();
+
+    float worldW = gi.cols * gi.cell, worldH = gi.rows * gi.cell;
+    float fit = max(worldW / WIN_W, worldH / WIN_H);
+    auto resetView = [&]() {
+        return sf::View(sf::FloatRect({gi.minX + worldW / 2 - WIN_W * fit / 2, gi.minY + worldH / 2 - WIN_H * fit / 2},
+                                      {WIN_W * fit, WIN_H * fit}));
+    };
+    sf::View view = resetView();
+
+    Scene scene;
+    bool dirty = true, dragging = false;
+    sf::Vector2i dragFrom;
+    sf::Clock fpsClock;
+    int frames = 0;
+
+    while (window.isOpen()) {
+        while (auto ev = window.pollEvent()) {
+            if (ev->is<sf::Event::Closed>()) window.close();
+
+            if (auto r = ev->getIf<sf::Event::Resized>()) {
+                float scale = view.getSize().x / window.getDefaultView().getSize().x;
+                view.setSize({r->size.x * scale, r->size.y * scale});
+                dirty = true;
+            }
+
+            // Zoom about the cursor so the world point under it stays put.
+            if (auto w = ev->getIf<sf::Event::MouseWheelScrolled>()) {
+                sf::Vector2f before = window.mapPixelToCoords(w->position, view);
+                view.zoom(w->delta > 0 ? 0.8f : 1.25f);
+                sf::Vector2f after = window.mapPixelToCoords(w->position, view);
+                view.move(before - after);
+                dirty = true;
+            }
+
+            if (auto m = ev->getIf<sf::Event::MouseButtonPressed>()) {
+                if (m->button == sf::Mouse::Button::Left) { dragging = true; dragFrom = m->position; }
+            }
+            if (auto m = ev->getIf<sf::Event::MouseButtonReleased>()) {
+                if (m->button == sf::Mouse::Button::Left) dragging = false;
+            }
+            if (auto m = ev->getIf<sf::Event::MouseMoved>()) {
+                if (dragging) {
+                    sf::Vector2f a = window.mapPixelToCoords(dragFrom, view);
+                    sf::Vector2f b = window.mapPixelToCoords(m->position, view);
+                    view.move(a - b);
+                    dragFrom = m->position;
+                    dirty = true;
+                }
+            }
+
+            if (auto k = ev->getIf<sf::Event::KeyPressed>()) {
+                if (k->code == sf::Keyboard::Key::R) { view = resetView(); dirty = true; }
+                if (k->code == sf::Keyboard::Key::Escape) window.close();
+            }
+        }
+
+        if (dirty) {
+            rebuildScene(scene, gi, pos, E, view, window.getSize());
+            dirty = false;
+        }
+
+        window.clear(sf::Color(235, 245, 255));
+        window.setView(view);
+        if (scene.densityMode) {
+            window.draw(scene.tiles);
+        } else {
+            window.draw(scene.lines);
+            window.draw(scene.points);
+            // Labels are drawn in screen space so text keeps a constant size.
+            float pxPerWorld = window.getSize().x / view.getSize().x;
+            sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.f;
+            window.setView(window.getDefaultView());
+            for (int v : scene.labelled) {
+                sf::Text t(font, "Node_" + to_string(v), 12);
+                t.setFillColor(sf::Color::Black);
+                t.setPosition(sf::Vector2f((pos[v].x - topLeft.x) * pxPerWorld + 5.f,
+                                           (pos[v].y - topLeft.y) * pxPerWorld - 8.f));
+                window.draw(t);
+            }
+        }
+        window.display();
+
+        if (++frames, fpsClock.getElapsedTime().asSeconds() >= 1.f) {
+            float fps = frames / fpsClock.restart().asSeconds();
+            window.setTitle("Large Graph Viewer | " + to_string((int)fps) + " FPS | " +
+                            (scene.densityMode ? string("density tiles")
+                                               : to_string(scene.drawnNodes) + " nodes, " +
+                                                 to_string(scene.drawnEdges) + " edges"));
+            frames = 0;
+        }
+    }
+}
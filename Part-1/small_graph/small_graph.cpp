@@ -1,5 +1,6 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -52,6 +53,31 @@ vector<int> generateHeuristics(const vector<sf::Vector2f>& pos, int goal) {
     return h;
 }
 
+// --- SEARCH TRACE OVERLAY ---
+// trace_overlay.csv (written by Part-2/a_star/trace_replay --overlay) lists
+// expanded nodes in expansion order; if present it is replayed over the graph.
+struct OverlayEntry { int order; bool onPath; };
+
+unordered_map<string, OverlayEntry> loadOverlay(const string& file) {
+    unordered_map<string, OverlayEntry> ov;
+    ifstream in(file);
+    if (!in) return ov;
+    string line;
+    getline(in, line); // skip header
+    while (getline(in, line)) {
+        stringstream ss(line);
+        string name, order, g, f, onPath;
+        getline(ss, name, ',');
+        getline(ss, order, ',');
+        getline(ss, g, ',');
+        getline(ss, f, ',');
+        getline(ss, onPath, ',');
+        if (name.empty() || order.empty()) continue;
+        ov[name] = {stoi(order), onPath == "1"};
+    }
+    return ov;
+}
+
 int main() {
     // ✅ Clean node list (duplicates + typos removed)
     vector<string> nodes = {
@@ -138,9 +164,18 @@ int main() {
     window.setFramerateLimit(60);
     sf::Font font = loadFont();
 
+    auto overlay = loadOverlay("trace_overlay.csv");
+    int overlayLen = (int)overlay.size();
+    int step = 0, frame = 0;   // one expansion revealed every 20 frames; R restarts
+    if (overlayLen) cout << "✓ replaying " << overlayLen << " expansions from trace_overlay.csv\n";
+
     while (window.isOpen()) {
-        while (auto ev = window.pollEvent())
+        while (auto ev = window.pollEvent()) {
             if (ev->is<sf::Event::Closed>()) window.close();
+            if (auto k = ev->getIf<sf::Event::KeyPressed>())
+                if (k->code == sf::Keyboard::Key::R) step = frame = 0;
+        }
+        if (overlayLen && step <= overlayLen && ++frame % 20 == 0) step++;
 
         window.clear(sf::Color(235,245,255));
 
@@ -168,8 +203,20 @@ int main() {
             c.setOrigin({10,10});
             c.setPosition(pos[i]);
             c.setFillColor(sf::Color(0,200,220));
+            auto ov = overlay.find(nodes[i]);
+            if (ov != overlay.end() && ov->second.order < step) {
+                bool done = step > overlayLen;
+                c.setFillColor(done && ov->second.onPath ? sf::Color::Red : sf::Color(255,150,0));
+            }
             window.draw(c);
 
+            if (ov != overlay.end() && ov->second.order < step) {
+                sf::Text otxt(font, "#" + to_string(ov->second.order), 12);
+                otxt.setFillColor(sf::Color::Magenta);
+                otxt.setPosition(sf::Vector2f(pos[i].x - 10.f, pos[i].y - 28.f));
+                window.draw(otxt);
+            }
+
             sf::Text label(font, nodes[i], 14);
             label.setFillColor(sf::Color::Black);
             label.setPosition(sf::Vector2f(pos[i].x + 15.f, pos[i].y - 10.f));
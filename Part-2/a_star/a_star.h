@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/graph_cache.h"
+#include "../common/road_graph.h"
+#include "../common/search_instrumentation.h"
+#include "../common/search_trace.h"
+#include "../common/spatial_index.h"
+
+using namespace std;
+
+// A* engine: included by a_star.cpp and by the benchmark, so both time the
+// same code.
+
+// ====================== Heuristics ======================
+// Heuristic values are resolved to node ids once at load time, so the search
+// reads h(v) from a flat array instead of hashing the node name per lookup.
+inline vector<float> load_heuristics(const Graph& g, const string& filename) {
+    vector<float> h(g.nodes.size(), 0.0f);
+    ifstream f(filename);
+    if (!f) { cerr << "Error: cannot open " << filename << endl; exit(1); }
+
+    string line;
+    getline(f, line); // skip header
+    while (getline(f, line)) {
+        if (Graph::trim(line).empty()) continue;
+        stringstream ss(line);
+        string name, val;
+        getline(ss, name, ',');
+        getline(ss, val, ',');
+        if (name.empty() || val.empty()) continue;
+        int id = g.findId(Graph::trim(name));
+        if (id < 0) continue;
+        try {
+            h[id] = stof(val);
+        } catch (...) {
+            // skip malformed lines
+        }
+    }
+    return h;
+}
+
+// heuristics.csv resolved to ids, cached under its own fingerprint: the table
+// depends on nodes.csv too, through the name -> id mapping.
+inline vector<float> load_heuristics(const Graph& g, const string& nodesFile, const string& heurFile,
+                                     const string& cacheDir) {
+    uint64_t fp = cacheDir.empty() ? 0 : fingerprint({nodesFile, heurFile});
+    string path = fp ? cache_path(cacheDir, "heur", fp) : string();
+    CacheReader rd;
+    size_t n = 0;
+    if (fp && rd.open(path, fp)) {
+        // A damaged table (NaN poisons every f comparison) is rebuilt like a miss.
+        const float* h = rd.get<float>(SEC_HEUR, n);
+        if (h && n == g.nodes.size() && none_of(h, h + n, [](float v) { return isnan(v); }))
+            return vector<float>(h, h + n);
+    }
+    vector<float> h = load_heuristics(g, heurFile);
+    if (fp) {
+        CacheWriter w;
+        w.add(SEC_HEUR, h);
+        w.save(path, "heur", fp);
+    }
+    return h;
+}
+
+// ====================== A* Algorithm ======================
+struct AStarStats {
+    size_t expansions = 0;
+    size_t maxFringe  = 0;
+    double ms         = 0.0;
+    float  pathCost   = INFINITY;
+    bool   rejected   = false;   // refused up front by the reachability filter
+    SearchCounters counters;
+    HwCounters hw;
+};
+
+inline vector<int> a_star(const Graph& g, int start, int goal,
+                          const vector<float>& heur, AStarStats& stats,
+                          TraceRecorder* trace = nullptr) {
+    if (!g.reach.mayReach(start, goal)) { stats.rejected = true; return {}; }
+    const int N = g.nodes.size();
+    vector<float> gCost(N, INFINITY), fCost(N, INFINITY);
+    vector<int> parent(N, -1);
+    vector<char> closed(N, 0);
+
+    auto h = [&](int v)->float { return v < (int)heur.size() ? heur[v] : 0.0f; };
+
+    gCost[start] = 0.0f;
+    fCost[start] = h(start);
+
+    using PQItem = pair<float, int>;
+    priority_queue<PQItem, vector<PQItem>, greater<PQItem>> open;
+    open.push({fCost[start], start});
+    COUNT(pushes, 1);
+    if (trace) {
+        trace->begin(start, goal);
+        trace->record(TraceEvent::Push, start, -1, 0.0f, fCost[start]);
+    }
+
+    PerfScope perf(stats.hw);
+    perf.start();
+    auto t0 = chrono::high_resolution_clock::now();
+
+    while (!open.empty()) {
+        stats.maxFringe = max(stats.maxFringe, open.size());
+        int u = open.top().second; open.pop();
+        COUNT(pops, 1);
+        COUNT(bytesTouched, sizeof(PQItem) + sizeof(char));
+        if (closed[u]) {
+            COUNT(stalePops, 1);
+            if (trace) trace->record(TraceEvent::Stale, u, parent[u], gCost[u], fCost[u]);
+            continue;
+        }
+        closed[u] = 1;
+        if (trace) trace->record(TraceEvent::Expand, u, parent[u], gCost[u], fCost[u]);
+        stats.expansions++;
+        if (u == goal) break;
+
+        auto it = g.adj.find(u);
+        if (it == g.adj.end()) continue;
+        for (const auto& e : it->second) {
+            COUNT(relaxations, 1);
+            COUNT(bytesTouched, sizeof(Edge) + sizeof(char));
+            if (closed[e.to]) continue;
+            float tentative = gCost[u] + e.w;
+            COUNT(bytesTouched, sizeof(float));
+            if (tentative < gCost[e.to]) {
+                gCost[e.to] = tentative;
+                parent[e.to] = u;
+                fCost[e.to] = tentative + h(e.to);
+                open.push({fCost[e.to], e.to});
+                if (trace) trace->record(TraceEvent::Push, e.to, u, tentative, fCost[e.to]);
+                COUNT(decreases, 1);
+                COUNT(pushes, 1);
+                COUNT(bytesTouched, 2 * sizeof(float) + sizeof(int) + sizeof(PQItem));
+            }
+        }
+    }
+
+    auto t1 = chrono::high_resolution_clock::now();
+    perf.stop();
+    stats.ms = chrono::duration<double, milli>(t1 - t0).count();
+
+    if (parent[goal] == -1 && start != goal) return {};
+
+    vector<int> path;
+    for (int v = goal; v != -1; v = parent[v]) {
+        path.push_back(v);
+        if (v == start) break;
+    }
+    reverse(path.begin(), path.end());
+    stats.pathCost = gCost[goal];
+    return path;
+}
+
+inline vector<int> a_star(const Graph& g, const string& startName, const string& goalName,
+                          const vector<float>& heur, AStarStats& stats,
+                          TraceRecorder* trace = nullptr) {
+    int start = g.findId(startName);
+    int goal  = g.findId(goalName);
+    if (start < 0 || goal < 0) {
+        cerr << "Unknown start/goal: " << startName << " -> " << goalName << endl;
+        return {};
+    }
+    return a_star(g, start, goal, heur, stats, trace);
+}
+
+// ====================== Multi-goal ======================
+// "Nearest of many targets" in one pass: the search runs until k targets are
+// settled. heuristics.csv only estimates distance to one goal, so the
+// multi-goal search uses the straight-line distance to the closest target,
+// scaled by the smallest weight/length ratio over all edges. That estimate
+// is zero on every target, never exceeds the cost to the nearest one, and is
+// consistent; targets are therefore settled nearest first with exact costs.
+
+inline float euclidean_scale(const Graph& g) {
+    float scale = INFINITY;
+    for (const auto& [u, es] : g.adj)
+        for (const auto& e : es) {
+            float dx = g.nodes[u].x - g.nodes[e.to].x, dy = g.nodes[u].y - g.nodes[e.to].y;
+            float len = sqrt(dx * dx + dy * dy);
+            if (len > 1e-6f) scale = min(scale, e.w / len);
+        }
+    return isfinite(scale) ? scale : 0.0f;
+}
+
+inline vector<TargetHit> a_star_nearest(const Graph& g, int start, const vector<int>& targets, size_t k,
+                                        float hScale, AStarStats& stats) {
+    const int N = g.nodes.size();
+    vector<float> gCost(N, INFINITY), fCost(N, INFINITY), hCache(N, -1.0f);
+    vector<int> parent(N, -1);
+    vector<char> closed(N, 0), isTarget(N, 0);
+    vector<int> goals;
+    for (int t : targets)
+        if (t >= 0 && t < N && !isTarget[t] && g.reach.mayReach(start, t)) { isTarget[t] = 1; goals.push_back(t); }
+    k = min(k, goals.size());
+
+    // min over targets, computed once per node that is actually reached
+    auto h = [&](int v)->float {
+        if (hCache[v] < 0.0f) {
+            float best = INFINITY;
+            for (int t : goals) {
+                float dx = g.nodes[v].x - g.nodes[t].x, dy = g.nodes[v].y - g.nodes[t].y;
+                best = min(best, dx * dx + dy * dy);
+            }
+            hCache[v] = goals.empty() ? 0.0f : hScale * sqrt(best);
+        }
+        return hCache[v];
+    };
+
+    gCost[start] = 0.0f;
+    fCost[start] = h(start);
+
+    using PQItem = pair<float, int>;
+    priority_queue<PQItem, vector<PQItem>, greater<PQItem>> open;
+    open.push({fCost[start], start});
+    COUNT(pushes, 1);
+
+    PerfScope perf(stats.hw);
+    perf.start();
+    auto t0 = chrono::high_resolution_clock::now();
+
+    vector<TargetHit> hits;
+    while (!open.empty() && hits.size() < k) {
+        stats.maxFringe = max(stats.maxFringe, open.size());
+        int u = open.top().second; open.pop();
+        COUNT(pops, 1);
+        COUNT(bytesTouched, sizeof(PQItem) + sizeof(char));
+        if (closed[u]) { COUNT(stalePops, 1); continue; }
+        closed[u] = 1;
+        stats.expansions++;
+
+        if (isTarget[u]) {
+            hits.push_back({u, gCost[u], {}});
+            if (hits.size() == k) break;
+        }
+
+        auto it = g.adj.find(u);
+        if (it == g.adj.end()) continue;
+        for (const auto& e : it->second) {
+            COUNT(relaxations, 1);
+            COUNT(bytesTouched, sizeof(Edge) + sizeof(char));
+            if (closed[e.to]) continue;
+            float tentative = gCost[u] + e.w;
+            COUNT(bytesTouched, sizeof(float));
+            if (tentative < gCost[e.to]) {
+                gCost[e.to] = tentative;
+                parent[e.to] = u;
+                fCost[e.to] = tentative + h(e.to);
+                open.push({fCost[e.to], e.to});
+                COUNT(decreases, 1);
+                COUNT(pushes, 1);
+                COUNT(bytesTouched, 2 * sizeof(float) + sizeof(int) + sizeof(PQItem));
+            }
+        }
+    }
+
+    auto t1 = chrono::high_resolution_clock::now();
+    perf.stop();
+    stats.ms = chrono::duration<double, milli>(t1 - t0).count();
+    stats.pathCost = hits.empty() ? INFINITY : hits.front().cost;
+
+    for (auto& hit : hits) {
+        for (int v = hit.target; v != -1; v = parent[v]) {
+            hit.path.push_back(v);
+            if (v == start) break;
+        }
+        reverse(hit.path.begin(), hit.path.end());
+    }
+    return hits;
+}
+
+inline vector<TargetHit> a_star_nearest(const Graph& g, const string& startName, const vector<string>& targetNames,
+                                        size_t k, float hScale, AStarStats& stats) {
+    int start = g.findId(startName);
+    if (start < 0) {
+        cerr << "Unknown start: " << startName << endl;
+        return {};
+    }
+    vector<int> targets;
+    for (const auto& name : targetNames) {
+        int id = g.findId(name);
+        if (id < 0) cerr << "Unknown target: " << name << endl;
+        else targets.push_back(id);
+    }
+    return a_star_nearest(g, start, targets, k, hScale, stats);
+}
+
+// Routes between arbitrary coordinates by snapping both ends to the nearest node.
+// heuristics.csv is only admissible for its own goal, and a snapped goal can be
+// any node, so this runs the single-target form of the search above.
+inline vector<int> a_star(const Graph& g, const KdTree& index, float sx, float sy, float gx, float gy,
+                          float hScale, AStarStats& stats) {
+    int start = index.nearest(sx, sy);
+    int goal  = index.nearest(gx, gy);
+    if (start < 0 || goal < 0) return {};
+    auto hits = a_star_nearest(g, start, {goal}, 1, hScale, stats);
+    return hits.empty() ? vector<int>{} : move(hits.front().path);
+}
+
+inline string stats_json(const AStarStats& s) {
+    ostringstream os;
+    os << "{\"expansions\":" << s.expansions << ",\"max_fringe\":" << s.maxFringe
+       << ",\"ms\":" << s.ms << ",\"path_cost\":"
+       << (isfinite(s.pathCost) ? to_string(s.pathCost) : string("null"))
+       << "," << counters_json(s.counters, s.hw) << "}";
+    return os.str();
+}
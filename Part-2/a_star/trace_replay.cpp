@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/search_trace.h"
+
+using namespace std;
+
+// Reads a trace written by a_star --trace (or Part-3 --trace) and prints
+// expansion statistics plus heuristic quality along the final path.
+// --overlay FILE writes the expansion order as CSV for small_graph.cpp.
+//
+// Usage: trace_replay TRACE [nodes.csv] [--overlay trace_overlay.csv]
+
+static unordered_map<int, string> load_names(const string& filename) {
+    unordered_map<int, string> names;
+    ifstream f(filename);
+    if (!f) return names;
+    string line;
+    getline(f, line); // skip header
+    while (getline(f, line)) {
+        stringstream ss(line);
+        string idStr, name;
+        getline(ss, idStr, ',');
+        getline(ss, name, ',');
+        if (idStr.empty()) continue;
+        try { names[stoi(idStr)] = name; } catch (...) {}
+    }
+    return names;
+}
+
+int main(int argc, char** argv) {
+    string traceFile, nodesFile = "nodes.csv", overlayFile;
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a == "--overlay" && i + 1 < argc) overlayFile = argv[++i];
+        else if (traceFile.empty()) traceFile = a;
+        else nodesFile = a;
+    }
+    if (traceFile.empty()) {
+        cerr << "Usage: trace_replay TRACE [nodes.csv] [--overlay FILE]" << endl;
+        return 1;
+    }
+
+    ifstream in(traceFile, ios::binary);
+    TraceHeader h{};
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h)) || memcmp(h.magic, "SRCHTRC1", 8) != 0 ||
+        h.recordSize != sizeof(TraceRecord)) {
+        cerr << "Error: " << traceFile << " is not a search trace" << endl;
+        return 1;
+    }
+    vector<TraceRecord> recs(h.stored);
+    in.read(reinterpret_cast<char*>(recs.data()), recs.size() * sizeof(TraceRecord));
+    recs.resize(in.gcount() / sizeof(TraceRecord));
+
+    auto names = load_names(nodesFile);
+    auto nameOf = [&](int v) {
+        auto it = names.find(v);
+        return it == names.end() ? "#" + to_string(v) : it->second;
+    };
+
+    // --- Replay ---
+    size_t pushes = 0, expands = 0, stale = 0, open = 0, maxOpen = 0, fDrops = 0;
+    float maxF = -INFINITY;
+    unordered_map<int, int> expandCount, parentOf;
+    unordered_map<int, float> gAtExpand, fAtExpand;
+    vector<int> order;
+    for (const auto& r : recs) {
+        switch ((TraceEvent)r.event) {
+        case TraceEvent::Push:
+            pushes++;
+            maxOpen = max(maxOpen, ++open);
+            break;
+        case TraceEvent::Stale:
+            stale++;
+            if (open) open--;
+            break;
+        case TraceEvent::Expand:
+            expands++;
+            if (open) open--;
+            // With a consistent heuristic f never decreases along the expansion order.
+            if (r.f + 1e-4f < maxF) fDrops++;
+            maxF = max(maxF, r.f);
+            if (expandCount[r.node]++ == 0) order.push_back(r.node);
+            parentOf[r.node] = r.parent;
+            gAtExpand[r.node] = r.g;
+            fAtExpand[r.node] = r.f;
+            break;
+        }
+    }
+
+    cout << fixed << setprecision(3);
+    cout << "Trace " << traceFile << ": " << nameOf(h.start) << " -> " << nameOf(h.goal) << "\n";
+    cout << "Records: " << recs.size() << " of " << h.emitted
+         << (h.emitted > h.stored ? " (ring wrapped, oldest records lost)" : "") << "\n";
+    cout << "Pushes: " << pushes << " | Expansions: " << expands << " | Stale pops: " << stale
+         << " | Max open: " << maxOpen << "\n";
+    size_t reexp = 0;
+    for (auto& [v, c] : expandCount) if (c > 1) reexp++;
+    cout << "Re-expanded nodes: " << reexp << " | f decreases between expansions: " << fDrops << "\n";
+
+    // --- Heuristic quality along the final path ---
+    // For a node on the optimal-as-found path, the true remaining cost is
+    // g(goal) - g(node); h = f - g is compared against it.
+    vector<int> path;
+    if (gAtExpand.count(h.goal)) {
+        for (int v = h.goal; v != -1 && path.size() <= order.size(); ) {
+            path.push_back(v);
+            auto it = parentOf.find(v);
+            v = (it == parentOf.end()) ? -1 : it->second;
+        }
+        reverse(path.begin(), path.end());
+    }
+    if (path.empty()) {
+        cout << "Goal not expanded in the recorded window; no path statistics.\n";
+    } else {
+        float gGoal = gAtExpand[h.goal];
+        double ratioSum = 0;
+        int ratioN = 0, over = 0;
+        float worstOver = 0;
+        cout << "\nPath (" << path.size() << " nodes, cost " << gGoal << "):\n";
+        cout << "  " << left << setw(28) << "node" << right << setw(10) << "g" << setw(10) << "h"
+             << setw(10) << "h*" << "\n";
+        for (int v : path) {
+            float g = gAtExpand[v], hv = fAtExpand[v] - g, hstar = gGoal - g;
+            cout << "  " << left << setw(28) << nameOf(v) << right << setw(10) << g << setw(10) << hv
+                 << setw(10) << hstar << (hv > hstar + 1e-4f ? "  overestimate" : "") << "\n";
+            if (hv > hstar + 1e-4f) { over++; worstOver = max(worstOver, hv - hstar); }
+            if (hstar > 0) { ratioSum += hv / hstar; ratioN++; }
+        }
+        cout << "Mean h/h*: " << (ratioN ? ratioSum / ratioN : 1.0)
+             << " | Overestimates: " << over << " (worst +" << worstOver << ")"
+             << " | Expansions per path node: " << (double)expands / path.size() << "\n";
+    }
+
+    if (!overlayFile.empty()) {
+        ofstream out(overlayFile);
+        out << "name,order,g,f,on_path\n";
+        for (size_t i = 0; i < order.size(); ++i) {
+            int v = order[i];
+            bool onPath = find(path.begin(), path.end(), v) != path.end();
+            out << nameOf(v) << "," << i << "," << gAtExpand[v] << "," << fAtExpand[v] << ","
+                << onPath << "\n";
+        }
+        cout << "Overlay written to " << overlayFile << "\n";
+    }
+}
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../common/road_graph.h"
+
+using namespace std;
+
+// Interleaved point-to-point Dijkstra: B independent queries advance in
+// lockstep on one thread. Each query's step is split into stages so a cache
+// miss it needs is prefetched, then the other B - 1 queries run before it
+// comes back to use the line. Throughput is compared against the same
+// queries run one after another, and every cost is checked against them.
+//
+// Usage: batched_dijkstra [--nodes nodes.csv] [--edges edges.csv] [--queries N]
+//                         [--batch 1,4,8,...] [--seed S]
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p) ((void)0)
+#endif
+
+// ====================== CSR ======================
+// Flat copy of the Graph. One expansion is three dependent loads: start[u],
+// then to/w[start[u]..start[u+1]), then dist/closed of each neighbour.
+struct Csr {
+    vector<int> start, to;
+    vector<float> w;
+
+    void build(const Graph& g) {
+        const int N = g.nodes.size();
+        start.assign(N + 1, 0);
+        for (auto& [u, es] : g.adj) start[u + 1] = es.size();
+        for (int u = 0; u < N; ++u) start[u + 1] += start[u];
+        to.resize(start[N]);
+        w.resize(start[N]);
+        for (auto& [u, es] : g.adj) {
+            int k = start[u];
+            for (auto& e : es) { to[k] = e.to; w[k] = e.w; ++k; }
+        }
+    }
+};
+
+// ====================== Query state ======================
+// dist/closed are allocated once per slot and reset through the touched
+// list, so starting a query costs O(nodes it reached), not O(N).
+struct QueryState {
+    using PQItem = pair<float,int>;
+    vector<float> dist;
+    vector<char> closed;
+    vector<int> touched;
+    vector<PQItem> heap;            // min-heap through greater<>
+    int goal = -1;
+    int node = -1;                  // node being expanded
+    int stage = 0;
+    size_t expansions = 0;
+    float cost = INFINITY;
+    bool done = true;
+
+    void init(int N) {
+        dist.assign(N, INFINITY);
+        closed.assign(N, 0);
+    }
+
+    void begin(int source, int target) {
+        for (int v : touched) { dist[v] = INFINITY; closed[v] = 0; }
+        touched.clear();
+        heap.clear();
+        goal = target;
+        stage = 0;
+        expansions = 0;
+        cost = INFINITY;
+        done = false;
+        dist[source] = 0.0f;
+        touched.push_back(source);
+        heap.push_back({0.0f, source});
+    }
+
+    // Pops until an unsettled node comes up; false once the goal is settled
+    // or the heap runs dry.
+    bool settleNext() {
+        while (!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), greater<PQItem>());
+            auto [d, u] = heap.back();
+            heap.pop_back();
+            if (closed[u]) continue;
+            closed[u] = 1;
+            expansions++;
+            if (u == goal) { cost = d; done = true; return false; }
+            node = u;
+            return true;
+        }
+        done = true;
+        return false;
+    }
+
+    void relax(const Csr& csr) {
+        float du = dist[node];
+        for (int k = csr.start[node], hi = csr.start[node + 1]; k < hi; ++k) {
+            int v = csr.to[k];
+            if (closed[v]) continue;
+            float alt = du + csr.w[k];
+            if (alt < dist[v]) {
+                if (dist[v] == INFINITY) touched.push_back(v);
+                dist[v] = alt;
+                heap.push_back({alt, v});
+                push_heap(heap.begin(), heap.end(), greater<PQItem>());
+            }
+        }
+    }
+};
+
+// ====================== Engines ======================
+// Serial baseline: the usual fused loop, one query at a time.
+void run_serial(const Csr& csr, QueryState& q) {
+    while (q.settleNext()) q.relax(csr);
+}
+
+// One stage of an interleaved query; the caller moves on to the next query
+// after every call, so each prefetch has B - 1 other stages to land.
+//   0: settle the next node, prefetch its CSR offsets
+//   1: read the offsets, prefetch its targets and weights
+//   2: read the targets, prefetch their dist / closed entries
+//   3: relax
+void step(const Csr& csr, QueryState& q, bool prefetch) {
+    switch (q.stage) {
+    case 0:
+        if (!q.settleNext()) return;
+        if (prefetch) PREFETCH(&csr.start[q.node]);
+        q.stage = 1;
+        return;
+    case 1:
+        if (prefetch) {
+            int lo = csr.start[q.node], hi = csr.start[q.node + 1];
+            for (int k = lo; k < hi; k += 16) { PREFETCH(&csr.to[k]); PREFETCH(&csr.w[k]); }
+            if (hi > lo) { PREFETCH(&csr.to[hi - 1]); PREFETCH(&csr.w[hi - 1]); }
+        }
+        q.stage = 2;
+        return;
+    case 2:
+        if (prefetch)
+            for (int k = csr.start[q.node], hi = csr.start[q.node + 1]; k < hi; ++k) {
+                PREFETCH(&q.dist[csr.to[k]]);
+                PREFETCH(&q.closed[csr.to[k]]);
+            }
+        q.stage = 3;
+        return;
+    default:
+        q.relax(csr);
+        q.stage = 0;
+        return;
+    }
+}
+
+struct RunResult {
+    double ms = 0.0;
+    size_t expansions = 0;
+    vector<float> costs;
+};
+
+RunResult run_queries(const Csr& csr, int N, const vector<pair<int,int>>& queries, int batch, bool prefetch) {
+    RunResult r;
+    r.costs.assign(queries.size(), INFINITY);
+    auto t0 = chrono::high_resolution_clock::now();
+    if (batch <= 0) {
+        QueryState q;
+        q.init(N);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            q.begin(queries[i].first, queries[i].second);
+            run_serial(csr, q);
+            r.costs[i] = q.cost;
+            r.expansions += q.expansions;
+        }
+    } else {
+        // Slots are refilled as their queries finish, so `batch` stay in flight.
+        vector<QueryState> slots(batch);
+        vector<long> owner(batch, -1);
+        size_t next = 0, finished = 0;
+        for (auto& q : slots) q.init(N);
+        while (finished < queries.size()) {
+            for (int s = 0; s < batch; ++s) {
+                QueryState& q = slots[s];
+                if (q.done) {
+                    if (owner[s] >= 0) {
+                        r.costs[owner[s]] = q.cost;
+                        r.expansions += q.expansions;
+                        finished++;
+                        owner[s] = -1;
+                    }
+                    if (next == queries.size()) continue;
+                    owner[s] = next;
+                    q.begin(queries[next].first, queries[next].second);
+                    next++;
+                }
+                step(csr, q, prefetch);
+            }
+        }
+    }
+    r.ms = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - t0).count();
+    return r;
+}
+
+// ====================== MAIN ======================
+int main(int argc, char** argv) {
+    string nodesFile = "../dijkstra/nodes.csv", edgesFile = "../dijkstra/edges.csv";
+    int queryCount = 256;
+    uint64_t seed = 42;
+    vector<int> batches = {1, 2, 4, 8, 16, 32};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string a = argv[i];
+        if (a == "--nodes") nodesFile = argv[i + 1];
+        else if (a == "--edges") edgesFile = argv[i + 1];
+        else if (a == "--queries") queryCount = stoi(argv[i + 1]);
+        else if (a == "--seed") seed = stoull(argv[i + 1]);
+        else if (a == "--batch") {
+            batches.clear();
+            stringstream ss(argv[i + 1]);
+            for (string tok; getline(ss, tok, ',');) if (!tok.empty()) batches.push_back(max(1, stoi(tok)));
+        }
+    }
+
+    Graph g;
+    if (nodesFile != "-") load_nodes(g, nodesFile);
+    load_edges(g, edgesFile);
+    const int N = g.nodes.size();
+    Csr csr;
+    csr.build(g);
+
+    vector<int> valid;
+    for (int i = 0; i < N; ++i) if (g.adj.count(i)) valid.push_back(i);
+    if (valid.empty()) { cerr << "Error: graph has no edges" << endl; return 1; }
+    mt19937_64 rng(seed);
+    uniform_int_distribution<size_t> pick(0, valid.size() - 1);
+    vector<pair<int,int>> queries;
+    for (int i = 0; i < queryCount; ++i) queries.push_back({valid[pick(rng)], valid[pick(rng)]});
+
+    cout << fixed << setprecision(3);
+    cout << "Graph: " << N << " node slots, " << csr.to.size() << " half-edges | " << queries.size()
+         << " queries\n\n";
+    cout << left << setw(12) << "mode" << right << setw(8) << "batch" << setw(12) << "ms" << setw(14)
+         << "queries/s" << setw(10) << "speedup" << setw(14) << "expansions" << setw(8) << "match" << "\n";
+
+    auto serial = run_queries(csr, N, queries, 0, false);
+    auto report = [&](const string& mode, int batch, const RunResult& r) {
+        bool match = true;
+        for (size_t i = 0; i < queries.size() && match; ++i) {
+            float a = serial.costs[i], b = r.costs[i];
+            if (isinf(a) != isinf(b) || (!isinf(a) && fabs(a - b) > 1e-4f * max(1.0f, a))) match = false;
+        }
+        cout << left << setw(12) << mode << right << setw(8) << batch << setw(12) << r.ms << setw(14)
+             << queries.size() / max(r.ms, 1e-9) * 1000.0 << setw(10) << serial.ms / max(r.ms, 1e-9)
+             << setw(14) << r.expansions << setw(8) << (match ? "yes" : "NO") << "\n";
+        return match;
+    };
+    bool allMatch = report("serial", 1, serial);
+    for (int b : batches) {
+        allMatch &= report("interleave", b, run_queries(csr, N, queries, b, false));
+        allMatch &= report("prefetch", b, run_queries(csr, N, queries, b, true));
+    }
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "road_graph.h"
+
+using namespace std;
+
+// ====================== Preprocessing Cache ======================
+// CSV parsing and the reachability build dominate start-up on large inputs,
+// so their results are saved as <dir>/<tag>-v<CACHE_VERSION>-<fingerprint>.bin
+// and mapped back on the next start. The fingerprint hashes the bytes of every
+// input file, so any edit misses the cache; bumping CACHE_VERSION retires
+// files written with an older layout. Saving removes the tag's older files.
+// Caching is opt-in (--cache DIR) because of that pruning.
+// Layout: header, section table, then 64-byte aligned raw arrays. Records are
+// written field by field into fixed-layout structs with zeroed padding, so
+// no uninitialised bytes reach the file.
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr char CACHE_MAGIC[8] = {'G', 'R', 'P', 'H', 'C', 'A', 'C', 'H'};
+
+enum CacheSection : uint32_t {
+    SEC_NODES = 1, SEC_NAMES, SEC_NAME_SLOTS, SEC_ADJ_START, SEC_ADJ_EDGES,
+    SEC_REACH_META, SEC_COMP, SEC_WEAK, SEC_LABELS, SEC_HEUR
+};
+
+struct CacheHeader { char magic[8]; uint32_t version; uint32_t sections; uint64_t fingerprint; };
+struct CacheEntry  { uint32_t id; uint32_t pad; uint64_t offset; uint64_t bytes; };
+struct CachedNode  { int32_t id; uint32_t nameLen; uint64_t nameOff; float x, y; };
+struct CachedEdge  { int32_t to; float w; uint8_t directed; uint8_t pad[3]; };
+
+// 64-bit hash over the contents of each file, 0 if one can't be read.
+inline uint64_t fingerprint(const vector<string>& files) {
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ CACHE_VERSION;
+    vector<char> buf(1 << 20);
+    for (const auto& name : files) {
+        FILE* f = fopen(name.c_str(), "rb");
+        if (!f) return 0;
+        uint64_t len = 0;
+        size_t n;
+        while ((n = fread(buf.data(), 1, buf.size(), f)) > 0) {
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                uint64_t w;
+                memcpy(&w, &buf[i], 8);
+                h = (h ^ w) * 0x100000001b3ull;
+                h ^= h >> 29;
+            }
+            for (; i < n; ++i) h = (h ^ (unsigned char)buf[i]) * 0x100000001b3ull;
+            len += n;
+        }
+        fclose(f);
+        h = (h ^ len) * 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 31;
+    }
+    return h ? h : 1;
+}
+
+inline string cache_path(const string& dir, const string& tag, uint64_t fp) {
+    ostringstream os;
+    os << dir << "/" << tag << "-v" << CACHE_VERSION << "-" << hex << setw(16) << setfill('0') << fp << ".bin";
+    return os.str();
+}
+
+struct CacheWriter {
+    struct Blob { uint32_t id; const void* data; size_t bytes; };
+    vector<Blob> blobs;
+
+    template <class T>
+    void add(uint32_t id, const vector<T>& v) { blobs.push_back({id, v.data(), v.size() * sizeof(T)}); }
+
+    // Writes to a temporary name and renames, so readers never see a partial
+    // file; then removes this tag's other cache files.
+    bool save(const string& path, const string& tag, uint64_t fp) const {
+        namespace fs = std::filesystem;
+        error_code ec;
+        fs::path target(path);
+        fs::create_directories(target.parent_path(), ec);
+        string tmp = path + ".tmp";
+        FILE* f = fopen(tmp.c_str(), "wb");
+        if (!f) return false;
+
+        CacheHeader h{};
+        memcpy(h.magic, CACHE_MAGIC, sizeof h.magic);
+        h.version = CACHE_VERSION;
+        h.sections = blobs.size();
+        h.fingerprint = fp;
+        vector<CacheEntry> table;
+        uint64_t off = sizeof(CacheHeader) + blobs.size() * sizeof(CacheEntry);
+        for (const auto& b : blobs) {
+            off = (off + 63) & ~uint64_t(63);
+            table.push_back({b.id, 0, off, b.bytes});
+            off += b.bytes;
+        }
+        bool ok = fwrite(&h, sizeof h, 1, f) == 1 &&
+                  fwrite(table.data(), sizeof(CacheEntry), table.size(), f) == table.size();
+        uint64_t pos = sizeof(CacheHeader) + blobs.size() * sizeof(CacheEntry);
+        static const char zeros[64] = {};
+        for (size_t i = 0; ok && i < blobs.size(); ++i) {
+            ok = fwrite(zeros, 1, table[i].offset - pos, f) == table[i].offset - pos &&
+                 fwrite(blobs[i].data, 1, blobs[i].bytes, f) == blobs[i].bytes;
+            pos = table[i].offset + blobs[i].bytes;
+        }
+        ok = (fclose(f) == 0) && ok;
+        if (ok) fs::rename(tmp, target, ec);
+        if (!ok || ec) { fs::remove(tmp, ec); return false; }
+
+        // Only names cache_path() could have produced: <tag>-v<digits>-<16 hex>.bin
+        auto ours = [&](const string& name) {
+            size_t i = tag.size() + 2;
+            if (name.compare(0, i, tag + "-v") != 0) return false;
+            size_t d = i;
+            while (d < name.size() && isdigit((unsigned char)name[d])) ++d;
+            if (d == i || name.size() != d + 1 + 16 + 4 || name[d] != '-' || name.compare(d + 17, 4, ".bin") != 0)
+                return false;
+            return all_of(name.begin() + d + 1, name.begin() + d + 17, [](char c) { return isxdigit((unsigned char)c); });
+        };
+        for (const auto& entry : fs::directory_iterator(target.parent_path(), ec))
+            if (entry.path() != target && ours(entry.path().filename().string())) fs::remove(entry.path(), ec);
+        return true;
+    }
+};
+
+struct CacheReader {
+    shared_ptr<MappedFile> file;
+    const CacheEntry* table = nullptr;
+    uint32_t sections = 0;
+
+    bool open(const string& path, uint64_t fp) {
+        auto f = make_shared<MappedFile>();
+        if (!f->open(path) || f->size < sizeof(CacheHeader)) return false;
+        const auto* h = reinterpret_cast<const CacheHeader*>(f->data);
+        if (memcmp(h->magic, CACHE_MAGIC, sizeof h->magic) != 0 || h->version != CACHE_VERSION ||
+            h->fingerprint != fp || sizeof(CacheHeader) + uint64_t(h->sections) * sizeof(CacheEntry) > f->size)
+            return false;
+        table = reinterpret_cast<const CacheEntry*>(f->data + sizeof(CacheHeader));
+        sections = h->sections;
+        for (uint32_t i = 0; i < sections; ++i)
+            if (table[i].offset > f->size || table[i].bytes > f->size - table[i].offset) return false;
+        file = move(f);
+        return true;
+    }
+
+    // Section id as an array of T; nullptr if it is missing or malformed.
+    template <class T>
+    const T* get(uint32_t id, size_t& count) const {
+        for (uint32_t i = 0; i < sections; ++i) {
+            if (table[i].id != id) continue;
+            if (table[i].bytes % sizeof(T) != 0) return nullptr;
+            count = table[i].bytes / sizeof(T);
+            return reinterpret_cast<const T*>(file->data + table[i].offset);
+        }
+        return nullptr;
+    }
+};
+
+// Adjacency is stored as CSR over node ids: edges of u are
+// edges[start[u], start[u+1]). It is copied back into Graph::adj, which every
+// search walks; only names and the name index stay in the mapping.
+inline bool restore_graph(Graph& g, const CacheReader& rd) {
+    size_t nNodes = 0, nNames = 0, nSlots = 0, nStart = 0, nEdges = 0, nMeta = 0, nComp = 0, nWeak = 0, nLabels = 0;
+    auto* nodes  = rd.get<CachedNode>(SEC_NODES, nNodes);
+    auto* names  = rd.get<char>(SEC_NAMES, nNames);
+    auto* slots  = rd.get<int32_t>(SEC_NAME_SLOTS, nSlots);
+    auto* start  = rd.get<uint64_t>(SEC_ADJ_START, nStart);
+    auto* edges  = rd.get<CachedEdge>(SEC_ADJ_EDGES, nEdges);
+    auto* meta   = rd.get<int32_t>(SEC_REACH_META, nMeta);
+    auto* comp   = rd.get<int32_t>(SEC_COMP, nComp);
+    auto* weak   = rd.get<int32_t>(SEC_WEAK, nWeak);
+    auto* labels = rd.get<int32_t>(SEC_LABELS, nLabels);
+    if (!nodes || !names || !slots || !start || !edges || !meta || !comp || !weak || !labels) return false;
+    // A file that passes the fingerprint can still be truncated or damaged on
+    // disk, and every id below is used unchecked by the searches, so anything
+    // out of range is a miss and the graph is rebuilt from the CSVs.
+    // meta: node count, SCC count, weak component count, labels per SCC
+    if (nMeta != 4 || meta[0] != (int32_t)nNodes || meta[3] != Reachability::LABELS ||
+        meta[1] < 0 || meta[2] < 0 || size_t(meta[1]) > nNodes || size_t(meta[2]) > nNodes ||
+        nStart != nNodes + 1 || start[0] != 0 || start[nStart - 1] != nEdges ||
+        (nComp && nComp != nNodes) || nWeak != nComp || nLabels != size_t(2) * Reachability::LABELS * meta[1])
+        return false;
+    for (size_t i = 0; i < nNodes; ++i)
+        if (nodes[i].nameLen > nNames || nodes[i].nameOff > nNames - nodes[i].nameLen) return false;
+    // Name index: empty, or a power-of-two table at most half full (lookups
+    // probe until a free slot) holding node ids.
+    if (nSlots & (nSlots - 1)) return false;
+    size_t used = 0;
+    for (size_t i = 0; i < nSlots; ++i) {
+        if (slots[i] < -1 || (slots[i] >= 0 && size_t(slots[i]) >= nNodes)) return false;
+        used += slots[i] >= 0;
+    }
+    if (used * 2 > nSlots) return false;
+    for (size_t i = 0; i < nComp; ++i)
+        if (comp[i] < 0 || comp[i] >= meta[1] || weak[i] < 0 || weak[i] >= meta[2]) return false;
+    // Labels: per SCC, 0 <= lo <= post < SCC count.
+    for (int i = 0; i < Reachability::LABELS; ++i) {
+        const int32_t* lo = labels + size_t(2 * i) * meta[1];
+        const int32_t* post = lo + meta[1];
+        for (int32_t c = 0; c < meta[1]; ++c)
+            if (lo[c] < 0 || lo[c] > post[c] || post[c] >= meta[1]) return false;
+    }
+
+    g.backing = rd.file;
+    g.nodes.resize(nNodes);
+    for (size_t i = 0; i < nNodes; ++i)
+        g.nodes[i] = {nodes[i].id, string_view(names + nodes[i].nameOff, nodes[i].nameLen), nodes[i].x, nodes[i].y};
+    g.nameSlots.assign(slots, slots + nSlots);
+    g.nameCount = used;
+    g.adj.reserve(nStart);
+    for (size_t u = 0; u + 1 < nStart; ++u) {
+        if (start[u + 1] == start[u]) continue;
+        if (start[u + 1] < start[u] || start[u + 1] > nEdges) return false;
+        auto& out = g.adj[u];
+        out.reserve(start[u + 1] - start[u]);
+        for (uint64_t k = start[u]; k < start[u + 1]; ++k) {
+            const CachedEdge& e = edges[k];
+            if (e.to < 0 || size_t(e.to) >= nNodes || !(e.w >= 0.0f)) return false;
+            out.push_back({e.to, e.w, e.directed != 0});
+        }
+    }
+
+    Reachability& r = g.reach;
+    r.comp.assign(comp, comp + nComp);
+    r.weak.assign(weak, weak + nWeak);
+    r.sccCount = meta[1];
+    r.weakCount = meta[2];
+    for (int i = 0; i < Reachability::LABELS; ++i) {
+        r.lo[i].assign(labels + size_t(2 * i) * r.sccCount, labels + size_t(2 * i + 1) * r.sccCount);
+        r.post[i].assign(labels + size_t(2 * i + 1) * r.sccCount, labels + size_t(2 * i + 2) * r.sccCount);
+    }
+    r.ms = 0.0;
+    return true;
+}
+
+inline bool save_graph(const Graph& g, const string& path, const string& tag, uint64_t fp) {
+    vector<CachedNode> nodes(g.nodes.size());
+    string names;
+    for (size_t i = 0; i < g.nodes.size(); ++i) {
+        const Node& n = g.nodes[i];
+        nodes[i] = {n.id, (uint32_t)n.name.size(), names.size(), n.x, n.y};
+        names.append(n.name);
+    }
+    vector<char> nameBytes(names.begin(), names.end());
+
+    int R = g.nodes.size();
+    for (const auto& [u, es] : g.adj) R = max(R, u + 1);
+    vector<uint64_t> start(R + 1, 0);
+    for (const auto& [u, es] : g.adj) start[u + 1] = es.size();
+    for (int u = 0; u < R; ++u) start[u + 1] += start[u];
+    vector<CachedEdge> edges(start[R]);
+    for (const auto& [u, es] : g.adj)
+        for (size_t k = 0; k < es.size(); ++k) {
+            CachedEdge& c = edges[start[u] + k];
+            c.to = es[k].to;
+            c.w = es[k].w;
+            c.directed = es[k].directed;
+            c.pad[0] = c.pad[1] = c.pad[2] = 0;
+        }
+
+    const Reachability& r = g.reach;
+    vector<int32_t> meta = {(int32_t)g.nodes.size(), r.sccCount, r.weakCount, Reachability::LABELS};
+    vector<int32_t> labels;
+    for (int i = 0; i < Reachability::LABELS; ++i) {
+        labels.insert(labels.end(), r.lo[i].begin(), r.lo[i].end());
+        labels.insert(labels.end(), r.post[i].begin(), r.post[i].end());
+    }
+
+    CacheWriter w;
+    w.add(SEC_NODES, nodes);
+    w.add(SEC_NAMES, nameBytes);
+    w.add(SEC_NAME_SLOTS, g.nameSlots);
+    w.add(SEC_ADJ_START, start);
+    w.add(SEC_ADJ_EDGES, edges);
+    w.add(SEC_REACH_META, meta);
+    w.add(SEC_COMP, r.comp);
+    w.add(SEC_WEAK, r.weak);
+    w.add(SEC_LABELS, labels);
+    return w.save(path, tag, fp);
+}
+
+// Runs build (which fills nodes and adjacency) and the reachability build,
+// or restores both from cacheDir when every input file is unchanged. tag
+// keeps graphs that different loaders make from the same files apart. An
+// empty cacheDir disables caching.
+inline void load_graph(Graph& g, const vector<string>& inputs, const string& tag, const string& cacheDir,
+                       const function<void(Graph&)>& build) {
+    auto t0 = chrono::high_resolution_clock::now();
+    auto ms = [&]() { return chrono::duration<double, milli>(chrono::high_resolution_clock::now() - t0).count(); };
+    uint64_t fp = cacheDir.empty() ? 0 : fingerprint(inputs);
+    string path = fp ? cache_path(cacheDir, tag, fp) : string();
+
+    CacheReader rd;
+    if (fp && rd.open(path, fp)) {
+        Graph cached;
+        if (restore_graph(cached, rd)) {
+            g = move(cached);
+            cerr << "Graph cache hit: " << path << " (" << fixed << setprecision(1) << ms() << " ms)\n";
+            return;
+        }
+    }
+    build(g);
+    g.reach.build(g.adj, g.nodes.size());
+    if (!fp) return;
+    bool saved = save_graph(g, path, tag, fp);
+    cerr << "Graph cache miss: built in " << fixed << setprecision(1) << ms() << " ms"
+         << (saved ? ", saved " + path : ", could not write " + path) << "\n";
+}
+
+// The Part-2 tools' graph: nodes.csv + edges.csv through the CSV loaders.
+inline void load_graph(Graph& g, const string& nodesFile, const string& edgesFile, const string& cacheDir) {
+    load_graph(g, {nodesFile, edgesFile}, "graph", cacheDir, [&](Graph& out) {
+        load_nodes(out, nodesFile);
+        load_edges(out, edgesFile);
+    });
+}
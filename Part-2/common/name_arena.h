@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Node names are copied back to back into fixed-size blocks, so a Node holds
+// only a string_view and growing the arena never moves existing names.
+// Shared by dijkstra, a_star and the benchmark.
+struct NameArena {
+    static constexpr size_t BLOCK = 1 << 16;
+    vector<unique_ptr<char[]>> blocks;
+    size_t used     = BLOCK;
+    size_t bytes    = 0;    // total name bytes stored
+    size_t reserved = 0;    // total bytes allocated
+
+    string_view intern(string_view s) {
+        if (s.empty()) return {};               // no block yet when the first name is empty
+        if (used + s.size() > BLOCK) {
+            size_t cap = max(BLOCK, s.size());  // oversized names get a block of their own
+            blocks.emplace_back(new char[cap]);
+            reserved += cap;
+            used = (cap == BLOCK) ? 0 : BLOCK - s.size();
+        }
+        char* p = blocks.back().get() + (s.size() > BLOCK ? 0 : used);
+        memcpy(p, s.data(), s.size());
+        used += s.size();
+        bytes += s.size();
+        return {p, s.size()};
+    }
+};
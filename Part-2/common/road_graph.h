@@ -0,0 +1,350 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "name_arena.h"
+
+using namespace std;
+
+// Road graph shared by the Part-2 tools and the benchmark: node / edge
+// layout, the name index, the reachability filter and the CSV loaders.
+
+// ====================== Structures ======================
+struct Edge { int to; float w; bool directed; };
+struct Node { int id; string_view name; float x, y; };
+
+// Read-only view of a whole file: mmap where available, otherwise read into
+// memory. Graph names restored from the preprocessing cache point into it.
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+#if defined(__unix__) || defined(__APPLE__)
+    void* addr = nullptr;
+
+    bool open(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+        addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) { addr = nullptr; return false; }
+        data = static_cast<const char*>(addr);
+        size = st.st_size;
+        return true;
+    }
+    ~MappedFile() { if (addr) munmap(addr, size); }
+#else
+    vector<char> bytes;
+
+    bool open(const string& path) {
+        ifstream f(path, ios::binary);
+        if (!f) return false;
+        bytes.assign(istreambuf_iterator<char>(f), {});
+        data = bytes.data();
+        size = bytes.size();
+        return size > 0;
+    }
+#endif
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+// Reachability filter, built once after loading. Strongly connected components (iterative Tarjan,
+// so long chains cannot overflow the call stack) collapse the graph into a
+// DAG, and every query is checked against O(1) necessary conditions for
+// start reaching goal:
+//   - both lie in the same weakly connected component,
+//   - comp(start) comes before comp(goal) in topological order,
+//   - goal's interval labels nest inside start's (GRAIL: one random DFS over
+//     the DAG per label, [min post-order below a component, its own post-order]).
+// Failing any test proves there is no path, so the query is rejected before
+// the search starts. Passing all of them only means "maybe", and the search
+// runs as usual.
+struct Reachability {
+    static constexpr int LABELS = 2;
+    vector<int> comp;                      // node -> SCC id; Tarjan finishes sinks first,
+                                           // so DAG edges always go to a smaller id
+    vector<int> weak;                      // node -> weakly connected component
+    vector<int> lo[LABELS], post[LABELS];  // per SCC interval labels
+    int sccCount = 0, weakCount = 0;
+    double ms = 0.0;
+
+    bool built() const { return !comp.empty(); }
+
+    bool mayReach(int s, int t) const {
+        if (!built() || s == t) return true;
+        int cs = comp[s], ct = comp[t];
+        if (cs == ct) return true;
+        if (weak[s] != weak[t] || cs < ct) return false;
+        for (int i = 0; i < LABELS; ++i)
+            if (lo[i][ct] < lo[i][cs] || post[i][ct] > post[i][cs]) return false;
+        return true;
+    }
+
+    void build(const unordered_map<int, vector<Edge>>& adj, int N) {
+        auto t0 = chrono::high_resolution_clock::now();
+        auto edgesOf = [&](int u) -> pair<const Edge*, const Edge*> {
+            auto it = adj.find(u);
+            if (it == adj.end() || it->second.empty()) return {nullptr, nullptr};
+            return {it->second.data(), it->second.data() + it->second.size()};
+        };
+
+        // Strong components.
+        comp.assign(N, -1);
+        sccCount = 0;
+        vector<int> index(N, -1), low(N, 0), stack;
+        vector<char> onStack(N, 0);
+        struct Frame { int u; const Edge* cur; const Edge* end; };
+        vector<Frame> calls;
+        int counter = 0;
+        auto open = [&](int v) {
+            index[v] = low[v] = counter++;
+            stack.push_back(v);
+            onStack[v] = 1;
+            auto [b, e] = edgesOf(v);
+            calls.push_back({v, b, e});
+        };
+        for (int r = 0; r < N; ++r) {
+            if (index[r] >= 0) continue;
+            open(r);
+            while (!calls.empty()) {
+                Frame& f = calls.back();
+                if (f.cur != f.end) {
+                    int u = f.u, v = (f.cur++)->to;
+                    if (index[v] < 0) open(v);
+                    else if (onStack[v]) low[u] = min(low[u], index[v]);
+                    continue;
+                }
+                int u = f.u;
+                calls.pop_back();
+                if (!calls.empty()) low[calls.back().u] = min(low[calls.back().u], low[u]);
+                if (low[u] != index[u]) continue;
+                int v;
+                do {
+                    v = stack.back(); stack.pop_back();
+                    onStack[v] = 0;
+                    comp[v] = sccCount;
+                } while (v != u);
+                sccCount++;
+            }
+        }
+
+        // Weak components (union-find over every edge, direction ignored).
+        vector<int> parent(N);
+        for (int i = 0; i < N; ++i) parent[i] = i;
+        auto find = [&](int x) {
+            while (parent[x] != x) x = parent[x] = parent[parent[x]];
+            return x;
+        };
+        for (const auto& [u, es] : adj)
+            for (const auto& e : es) parent[find(u)] = find(e.to);
+        weak.assign(N, -1);
+        vector<int> weakId(N, -1);
+        weakCount = 0;
+        for (int i = 0; i < N; ++i) {
+            int r = find(i);
+            if (weakId[r] < 0) weakId[r] = weakCount++;
+            weak[i] = weakId[r];
+        }
+
+        // Condensation DAG in CSR form, duplicate arcs removed.
+        vector<pair<int,int>> arcs;
+        for (const auto& [u, es] : adj)
+            for (const auto& e : es)
+                if (comp[u] != comp[e.to]) arcs.push_back({comp[u], comp[e.to]});
+        sort(arcs.begin(), arcs.end());
+        arcs.erase(unique(arcs.begin(), arcs.end()), arcs.end());
+        vector<int> start(sccCount + 1, 0), to(arcs.size());
+        for (size_t i = 0; i < arcs.size(); ++i) { start[arcs[i].first + 1]++; to[i] = arcs[i].second; }
+        for (int c = 0; c < sccCount; ++c) start[c + 1] += start[c];
+
+        // Interval labels: post-order DFS with shuffled roots and children.
+        mt19937 rng(12345);
+        vector<int> roots(sccCount);
+        vector<pair<int,int>> dfs;   // component, next child offset
+        for (int i = 0; i < LABELS; ++i) {
+            lo[i].assign(sccCount, -1);
+            post[i].assign(sccCount, -1);
+            for (int c = 0; c < sccCount; ++c) {
+                roots[c] = c;
+                shuffle(to.begin() + start[c], to.begin() + start[c + 1], rng);
+            }
+            shuffle(roots.begin(), roots.end(), rng);
+            int rank = 0;
+            for (int r : roots) {
+                if (lo[i][r] >= 0) continue;
+                lo[i][r] = INT32_MAX;
+                dfs.push_back({r, start[r]});
+                while (!dfs.empty()) {
+                    auto& [c, k] = dfs.back();
+                    if (k < start[c + 1]) {
+                        int d = to[k++];
+                        if (lo[i][d] < 0) { lo[i][d] = INT32_MAX; dfs.push_back({d, start[d]}); }
+                        else lo[i][c] = min(lo[i][c], lo[i][d]);   // finished: acyclic, no back arcs
+                        continue;
+                    }
+                    post[i][c] = rank++;
+                    lo[i][c] = min(lo[i][c], post[i][c]);
+                    int done = c;
+                    dfs.pop_back();
+                    if (!dfs.empty()) lo[i][dfs.back().first] = min(lo[i][dfs.back().first], lo[i][done]);
+                }
+            }
+        }
+
+        auto t1 = chrono::high_resolution_clock::now();
+        ms = chrono::duration<double, milli>(t1 - t0).count();
+    }
+};
+
+struct Graph {
+    unordered_map<int, vector<Edge>> adj;
+    vector<Node> nodes;
+    NameArena names;
+    shared_ptr<const MappedFile> backing;   // cache file that restored names point into
+    Reachability reach;
+    // Open-addressing name index: node ids in a power-of-two table, linear
+    // probing, -1 for empty slots; keys are compared through nodes[id].name.
+    vector<int32_t> nameSlots;
+    size_t nameCount = 0;
+
+    static uint64_t hashName(string_view s) {          // FNV-1a
+        uint64_t h = 1469598103934665603ull;
+        for (unsigned char c : s) { h ^= c; h *= 1099511628211ull; }
+        return h;
+    }
+
+    int findId(string_view name) const {
+        if (nameSlots.empty()) return -1;
+        size_t mask = nameSlots.size() - 1;
+        for (size_t i = hashName(name) & mask;; i = (i + 1) & mask) {
+            int id = nameSlots[i];
+            if (id < 0) return -1;
+            if (nodes[id].name == name) return id;
+        }
+    }
+
+    void indexName(int id) {
+        if ((nameCount + 1) * 2 > nameSlots.size()) {   // keep load factor <= 1/2
+            vector<int32_t> old(max<size_t>(16, nameSlots.size() * 2), -1);
+            old.swap(nameSlots);
+            nameCount = 0;
+            for (int32_t v : old) if (v >= 0) indexName(v);
+        }
+        size_t mask = nameSlots.size() - 1;
+        size_t i = hashName(nodes[id].name) & mask;
+        while (nameSlots[i] >= 0 && nodes[nameSlots[i]].name != nodes[id].name) i = (i + 1) & mask;
+        if (nameSlots[i] < 0) nameCount++;
+        nameSlots[i] = id;                              // a repeated name maps to the latest id
+    }
+
+    static string trim(const string& s) {
+        size_t b = 0, e = s.size();
+        while (b < e && isspace((unsigned char)s[b])) ++b;
+        while (e > b && isspace((unsigned char)s[e - 1])) --e;
+        return s.substr(b, e - b);
+    }
+
+    void addNode(int id, string_view name, float x, float y) {
+        if ((int)nodes.size() <= id) nodes.resize(id + 1);
+        nodes[id] = {id, names.intern(name), x, y};
+        indexName(id);
+    }
+
+    void addEdge(int u, int v, float w, bool directed) {
+        adj[u].push_back({v, w, directed});
+        if (!directed) adj[v].push_back({u, w, directed});
+    }
+};
+
+// ====================== CSV Loaders ======================
+inline void load_nodes(Graph& g, const string& filename) {
+    ifstream f(filename);
+    if (!f) { cerr << "Error: cannot open " << filename << endl; exit(1); }
+
+    string line;
+    getline(f, line);
+    while (getline(f, line)) {
+        if (Graph::trim(line).empty()) continue;
+        stringstream ss(line);
+        string idStr, name, xStr, yStr;
+        getline(ss, idStr, ',');
+        getline(ss, name, ',');
+        getline(ss, xStr, ',');
+        getline(ss, yStr, ',');
+        if (idStr.empty() || name.empty()) continue;
+        int id = stoi(idStr);
+        float x = xStr.empty() ? 0 : stof(xStr);
+        float y = yStr.empty() ? 0 : stof(yStr);
+        g.addNode(id, Graph::trim(name), x, y);
+    }
+}
+
+inline void load_edges(Graph& g, const string& filename) {
+    ifstream f(filename);
+    if (!f) { cerr << "Error: cannot open " << filename << endl; exit(1); }
+
+    string line;
+    getline(f, line);
+    while (getline(f, line)) {
+        if (Graph::trim(line).empty()) continue;
+        stringstream ss(line);
+        string fromStr, toStr, wStr, dStr;
+        getline(ss, fromStr, ',');
+        getline(ss, toStr, ',');
+        getline(ss, wStr, ',');
+        getline(ss, dStr, ',');
+        if (fromStr.empty() || toStr.empty() || wStr.empty()) continue;
+        int u = stoi(fromStr);
+        int v = stoi(toStr);
+        float w = stof(wStr);
+        bool directed = (!dStr.empty() && stoi(dStr) != 0);
+        // Edge-only inputs (sample_graph_edges.csv) have no nodes file.
+        if ((int)g.nodes.size() <= max(u, v)) g.nodes.resize(max(u, v) + 1);
+        g.addEdge(u, v, w, directed);
+    }
+}
+
+// ====================== Utility ======================
+// One target settled by a multi-goal search, with its cost and path.
+struct TargetHit { int target; float cost; vector<int> path; };
+
+// Sum of the cheapest edge weight along path (parallel edges count at their
+// lowest weight, as the searches use them), INFINITY if a hop is missing.
+inline float path_cost(const Graph& g, const vector<int>& path) {
+    float cost = 0.0f;
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        int u = path[i], v = path[i + 1];
+        float edgeCost = INFINITY;
+        auto it = g.adj.find(u);
+        if (it != g.adj.end()) {
+            for (const auto& e : it->second)
+                if (e.to == v) edgeCost = min(edgeCost, e.w);
+        }
+        if (edgeCost == INFINITY) return INFINITY;
+        cost += edgeCost;
+    }
+    return cost;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#if defined(__linux__) && defined(SEARCH_PERF)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Hot-path counters are compiled in with -DSEARCH_COUNTERS; otherwise COUNT()
+// expands to nothing and the search loop is identical to the plain build.
+// -DSEARCH_PERF additionally reads hardware counters on Linux.
+#ifdef SEARCH_COUNTERS
+#define COUNT(field, n) (stats.counters.field += (n))
+#else
+#define COUNT(field, n) ((void)0)
+#endif
+
+struct SearchCounters {
+    size_t relaxations  = 0;   // edges examined out of expanded nodes
+    size_t decreases    = 0;   // relaxations that lowered a tentative cost
+    size_t pushes       = 0;
+    size_t pops         = 0;
+    size_t stalePops    = 0;   // pops of already-closed nodes
+    size_t bytesTouched = 0;   // estimated graph + search-state bytes read or written
+};
+
+struct HwCounters { long long cycles = -1, cacheMisses = -1, branchMisses = -1; };
+
+// Counts cycles / cache misses / branch misses between start() and stop(). The
+// events are opened in the constructor so the perf syscalls stay outside the
+// caller's timed window: construct, start(), read the clock, search, read
+// the clock, stop().
+// Values stay -1 without -DSEARCH_PERF, off Linux, or when the kernel refuses
+// the events (see /proc/sys/kernel/perf_event_paranoid).
+struct PerfScope {
+#if defined(__linux__) && defined(SEARCH_PERF)
+    HwCounters& out;
+    int fds[3] = {-1, -1, -1};
+
+    explicit PerfScope(HwCounters& o) : out(o) {
+        const uint64_t configs[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES,
+                                     PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < 3; ++i) {
+            perf_event_attr pe{};
+            pe.type = PERF_TYPE_HARDWARE;
+            pe.size = sizeof(pe);
+            pe.config = configs[i];
+            pe.disabled = 1;
+            pe.exclude_kernel = 1;
+            pe.exclude_hv = 1;
+            fds[i] = (int)syscall(SYS_perf_event_open, &pe, 0, -1, -1, 0);
+        }
+    }
+
+    void start() {
+        for (int fd : fds)
+            if (fd >= 0) { ioctl(fd, PERF_EVENT_IOC_RESET, 0); ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); }
+    }
+
+    void stop() {
+        long long* dst[3] = {&out.cycles, &out.cacheMisses, &out.branchMisses};
+        for (int i = 0; i < 3; ++i) {
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            long long v;
+            if (read(fds[i], &v, sizeof(v)) == (ssize_t)sizeof(v)) *dst[i] = v;
+            close(fds[i]);
+            fds[i] = -1;
+        }
+    }
+
+    ~PerfScope() { stop(); }
+#else
+    explicit PerfScope(HwCounters&) {}
+    void start() {}
+    void stop() {}
+#endif
+};
+
+inline string counters_json(const SearchCounters& c, const HwCounters& hw) {
+    ostringstream os;
+#ifdef SEARCH_COUNTERS
+    os << "\"counters\":{\"relaxations\":" << c.relaxations << ",\"decreases\":" << c.decreases
+       << ",\"pushes\":" << c.pushes << ",\"pops\":" << c.pops << ",\"stale_pops\":" << c.stalePops
+       << ",\"bytes_touched\":" << c.bytesTouched << "}";
+#else
+    (void)c;
+    os << "\"counters\":null";
+#endif
+    auto num = [](long long v) { return v < 0 ? string("null") : to_string(v); };
+    os << ",\"hw\":{\"cycles\":" << num(hw.cycles) << ",\"cache_misses\":" << num(hw.cacheMisses)
+       << ",\"branch_misses\":" << num(hw.branchMisses) << "}";
+    return os.str();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Opt-in recorder: each push / expansion appends one fixed-size record to a
+// preallocated power-of-two ring, so tracing costs a store and an increment.
+// When the ring wraps only the newest records survive. trace_replay reads
+// the saved file; a_star, Part-3 and the benchmark all record through this.
+enum class TraceEvent : uint8_t { Push = 0, Expand = 1, Stale = 2 };
+
+struct TraceRecord {
+    int32_t node;
+    int32_t parent;
+    float   g;
+    float   f;
+    uint8_t event;
+    uint8_t pad[3];
+};
+static_assert(sizeof(TraceRecord) == 20, "trace files rely on a 20-byte record");
+
+struct TraceHeader {
+    char     magic[8];     // "SRCHTRC1"
+    uint32_t recordSize;
+    int32_t  start, goal;
+    uint32_t reserved;
+    uint64_t emitted;      // records produced by the search
+    uint64_t stored;       // records in the file (< emitted if the ring wrapped)
+};
+
+struct TraceRecorder {
+    vector<TraceRecord> ring;
+    uint64_t mask = 0, emitted = 0;
+    int start = -1, goal = -1;
+
+    explicit TraceRecorder(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        ring.resize(cap);
+        mask = cap - 1;
+    }
+
+    void begin(int s, int t) { emitted = 0; start = s; goal = t; }
+
+    void record(TraceEvent ev, int node, int parent, float g, float f) {
+        ring[emitted & mask] = {node, parent, g, f, (uint8_t)ev, {0, 0, 0}};
+        ++emitted;
+    }
+
+    bool save(const string& filename) const {
+        ofstream out(filename, ios::binary);
+        if (!out) return false;
+        uint64_t stored = min<uint64_t>(emitted, ring.size());
+        TraceHeader h{};
+        memcpy(h.magic, "SRCHTRC1", 8);
+        h.recordSize = sizeof(TraceRecord);
+        h.start = start;
+        h.goal = goal;
+        h.emitted = emitted;
+        h.stored = stored;
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        for (uint64_t i = emitted - stored; i < emitted; ++i)
+            out.write(reinterpret_cast<const char*>(&ring[i & mask]), sizeof(TraceRecord));
+        return (bool)out;
+    }
+};
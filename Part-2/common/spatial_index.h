@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "road_graph.h"
+
+using namespace std;
+
+// ====================== Spatial Index ======================
+// Static 2-d tree over node coordinates. The tree is implicit: for every
+// range [lo, hi) the median sits at mid and splits on x at even depths, y at
+// odd ones, so no child pointers are stored.
+struct KdTree {
+    vector<int> ids;          // node ids in tree order
+    vector<float> xs, ys;     // coordinates in tree order
+
+    void build(const Graph& g) {
+        ids.clear();
+        for (const auto& n : g.nodes)
+            if (!n.name.empty()) ids.push_back(n.id);
+        buildRange(g, 0, (int)ids.size(), 0);
+        xs.resize(ids.size());
+        ys.resize(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            xs[i] = g.nodes[ids[i]].x;
+            ys[i] = g.nodes[ids[i]].y;
+        }
+    }
+
+    int nearest(float x, float y) const {
+        auto best = kNearest(x, y, 1);
+        return best.empty() ? -1 : best[0];
+    }
+
+    // Node ids of the k closest nodes, nearest first.
+    vector<int> kNearest(float x, float y, size_t k) const {
+        vector<pair<float,int>> heap; // max-heap on squared distance
+        if (k > 0) search(x, y, k, 0, (int)ids.size(), 0, heap);
+        sort_heap(heap.begin(), heap.end());
+        vector<int> out;
+        for (auto& [d, i] : heap) out.push_back(ids[i]);
+        return out;
+    }
+
+private:
+    void buildRange(const Graph& g, int lo, int hi, int depth) {
+        if (hi - lo <= 1) return;
+        int mid = (lo + hi) / 2;
+        nth_element(ids.begin() + lo, ids.begin() + mid, ids.begin() + hi, [&](int a, int b) {
+            return depth % 2 == 0 ? g.nodes[a].x < g.nodes[b].x : g.nodes[a].y < g.nodes[b].y;
+        });
+        buildRange(g, lo, mid, depth + 1);
+        buildRange(g, mid + 1, hi, depth + 1);
+    }
+
+    void search(float x, float y, size_t k, int lo, int hi, int depth,
+                vector<pair<float,int>>& heap) const {
+        if (lo >= hi) return;
+        int mid = (lo + hi) / 2;
+        float dx = xs[mid] - x, dy = ys[mid] - y;
+        float d2 = dx * dx + dy * dy;
+        if (heap.size() < k) {
+            heap.push_back({d2, mid});
+            push_heap(heap.begin(), heap.end());
+        } else if (d2 < heap.front().first) {
+            pop_heap(heap.begin(), heap.end());
+            heap.back() = {d2, mid};
+            push_heap(heap.begin(), heap.end());
+        }
+        float split = (depth % 2 == 0) ? dx : dy; // signed offset of the splitting plane
+        int nearLo = split > 0 ? lo : mid + 1, nearHi = split > 0 ? mid : hi;
+        int farLo  = split > 0 ? mid + 1 : lo, farHi  = split > 0 ? hi : mid;
+        search(x, y, k, nearLo, nearHi, depth + 1, heap);
+        if (heap.size() < k || split * split < heap.front().first)
+            search(x, y, k, farLo, farHi, depth + 1, heap);
+    }
+};
+
+// Snaps many points at once; each thread handles one contiguous slice.
+inline vector<int> snap_batch(const KdTree& index, const vector<pair<float,float>>& pts,
+                              unsigned threads = thread::hardware_concurrency()) {
+    vector<int> out(pts.size(), -1);
+    threads = max(1u, min<unsigned>(threads, (pts.size() + 4095) / 4096));
+    vector<thread> pool;
+    size_t chunk = (pts.size() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t b = t * chunk, e = min(pts.size(), b + chunk);
+        pool.emplace_back([&, b, e] {
+            for (size_t i = b; i < e; ++i) out[i] = index.nearest(pts[i].first, pts[i].second);
+        });
+    }
+    for (auto& th : pool) th.join();
+    return out;
+}
+
+// --snap-bench N: snaps N random points inside the node bounding box at 1, 2,
+// 4, ... threads and reports points per second. Every run is checked against
+// the single-threaded answers.
+inline void snap_benchmark(const Graph& g, const KdTree& index, size_t n) {
+    if (g.nodes.empty() || n == 0) return;
+    float x0 = INFINITY, y0 = INFINITY, x1 = -INFINITY, y1 = -INFINITY;
+    for (const auto& nd : g.nodes) {
+        x0 = min(x0, nd.x); x1 = max(x1, nd.x);
+        y0 = min(y0, nd.y); y1 = max(y1, nd.y);
+    }
+    mt19937 rng(4242);
+    uniform_real_distribution<float> ux(x0, x1), uy(y0, y1);
+    vector<pair<float,float>> pts(n);
+    for (auto& p : pts) p = {ux(rng), uy(rng)};
+
+    vector<int> reference;
+    unsigned hw = max(1u, thread::hardware_concurrency());
+    for (unsigned t = 1;; t = min(hw, t * 2)) {
+        auto t0 = chrono::high_resolution_clock::now();
+        auto out = snap_batch(index, pts, t);
+        auto t1 = chrono::high_resolution_clock::now();
+        double ms = chrono::duration<double, milli>(t1 - t0).count();
+        if (reference.empty()) reference = out;
+        cout << "Snap " << n << " points | threads: " << t << " | " << fixed << setprecision(3) << ms
+             << " ms | " << setprecision(2) << n / ms / 1000.0 << " M points/s"
+             << (out == reference ? "" : " | MISMATCH") << "\n";
+        if (t == hw) break;
+    }
+}
@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../dijkstra/dijkstra.h"
+
+using namespace std;
+
+// Compact adjacency for the Part-2 graphs: node ids renumbered densely, then
+// per-node neighbour lists sorted by id, delta + varint coded, each followed
+// by an 8- or 16-bit weight. Dijkstra decodes the list sequentially while
+// relaxing. Results are checked against the Part-2 dijkstra() on the
+// unordered_map<int, vector<Edge>> layout.
+//
+// Usage: compressed_graph [--nodes nodes.csv] [--edges edges.csv] [--queries N] [--seed S]
+
+// ====================== Compressed Graph ======================
+// Nodes that appear in the graph are renumbered 0..n-1 in increasing original
+// id, so offsets and search state scale with n rather than the largest id
+// (SNAP files leave most ids unused). The order is kept, which keeps deltas
+// small; origId maps back and a binary search maps forward.
+// Per node u, byte stream of (varint delta, weight) pairs, in dense ids:
+//   first delta = zigzag(v0 - u), later deltas = v_i - v_{i-1} (>= 0, sorted)
+// Weights are stored as round(w * weightScale) in weightBytes bytes. Integer
+// weights up to 255 (build_large_graph writes 1..20) are exact in one byte.
+struct CompressedGraph {
+    vector<int>      origId;      // dense id -> original id, sorted
+    vector<uint32_t> offset;      // n + 1 byte offsets into bytes
+    vector<uint8_t>  bytes;
+    int   weightBytes = 1;
+    float weightScale = 1.0f;
+    float invScale    = 1.0f;     // multiply on decode instead of dividing
+    float maxQuantError = 0.0f;   // largest |decoded - original| weight
+
+    static uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+    static int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+    void putVarint(uint32_t v) {
+        while (v >= 0x80) { bytes.push_back((uint8_t)(v | 0x80)); v >>= 7; }
+        bytes.push_back((uint8_t)v);
+    }
+
+    int nodeCount() const { return (int)origId.size(); }
+
+    // Dense id of an original id, or -1 if the node is not in the graph.
+    int denseId(int orig) const {
+        auto it = lower_bound(origId.begin(), origId.end(), orig);
+        return it != origId.end() && *it == orig ? int(it - origId.begin()) : -1;
+    }
+
+    void build(const Graph& g) {
+        origId.clear();
+        for (size_t i = 0; i < g.nodes.size(); ++i)
+            if (!g.nodes[i].name.empty()) origId.push_back((int)i);
+        for (auto& [u, es] : g.adj) {
+            origId.push_back(u);
+            for (auto& e : es) origId.push_back(e.to);
+        }
+        sort(origId.begin(), origId.end());
+        origId.erase(unique(origId.begin(), origId.end()), origId.end());
+        origId.shrink_to_fit();
+        const int N = nodeCount();
+
+        float maxW = 0.0f;
+        bool integral = true;
+        for (auto& [u, es] : g.adj)
+            for (auto& e : es) {
+                maxW = max(maxW, e.w);
+                integral = integral && e.w >= 0 && e.w == floor(e.w);
+            }
+        if (integral && maxW <= 255.f)        { weightBytes = 1; weightScale = 1.0f; }
+        else if (integral && maxW <= 65535.f) { weightBytes = 2; weightScale = 1.0f; }
+        else                                  { weightBytes = 2; weightScale = 65535.f / max(maxW, 1e-6f); }
+
+        invScale = 1.0f / weightScale;
+
+        offset.assign(N + 1, 0);
+        bytes.clear();
+        vector<pair<int,float>> list;
+        for (int u = 0; u < N; ++u) {
+            offset[u] = bytes.size();
+            auto it = g.adj.find(origId[u]);
+            if (it == g.adj.end()) continue;
+            list.clear();
+            for (auto& e : it->second) list.push_back({denseId(e.to), e.w});
+            sort(list.begin(), list.end());
+            int prev = u;
+            bool first = true;
+            for (auto [v, w] : list) {
+                putVarint(first ? zigzag(v - prev) : (uint32_t)(v - prev));
+                first = false;
+                prev = v;
+                uint32_t q = (uint32_t)lround(w * weightScale);
+                maxQuantError = max(maxQuantError, fabs(q * invScale - w));
+                bytes.push_back((uint8_t)q);
+                if (weightBytes == 2) bytes.push_back((uint8_t)(q >> 8));
+            }
+        }
+        offset[N] = bytes.size();
+        bytes.shrink_to_fit();
+    }
+
+    size_t memoryBytes() const {
+        return origId.size() * sizeof(int) + offset.size() * sizeof(uint32_t) + bytes.size();
+    }
+
+    // Calls f(v, w) for every out-neighbour of u, decoding in place.
+    template <class F>
+    void forEachNeighbor(int u, F&& f) const {
+        const uint8_t* p = bytes.data() + offset[u];
+        const uint8_t* end = bytes.data() + offset[u + 1];
+        int prev = u;
+        bool first = true;
+        while (p < end) {
+            uint32_t d = *p & 0x7f;
+            for (int shift = 7; *p++ & 0x80; shift += 7) d |= (uint32_t)(*p & 0x7f) << shift;
+            int v = first ? prev + unzigzag(d) : prev + (int)d;
+            first = false;
+            prev = v;
+            uint32_t q = *p++;
+            if (weightBytes == 2) q |= (uint32_t)(*p++) << 8;
+            f(v, q * invScale);
+        }
+    }
+};
+
+// ====================== Dijkstra ======================
+// The reference is Part-2 dijkstra() from dijkstra.h, on the map-of-vectors
+// layout; this is the same search over the compressed lists.
+// Takes and returns original ids; searches in dense ids.
+vector<int> dijkstra(const CompressedGraph& cg, int startId, int goalId, DijkstraStats& stats) {
+    int start = cg.denseId(startId), goal = cg.denseId(goalId);
+    if (start < 0 || goal < 0) return {};
+    const int N = cg.nodeCount();
+    vector<float> dist(N, INFINITY);
+    vector<int> parent(N, -1);
+    vector<char> closed(N, 0);
+    using PQItem = pair<float,int>;
+    priority_queue<PQItem, vector<PQItem>, greater<PQItem>> open;
+    dist[start] = 0.0f;
+    open.push({0.0f, start});
+    auto t0 = chrono::high_resolution_clock::now();
+    while (!open.empty()) {
+        stats.maxFringe = max(stats.maxFringe, open.size());
+        int u = open.top().second; open.pop();
+        if (closed[u]) continue;
+        closed[u] = 1;
+        stats.expansions++;
+        if (u == goal) break;
+        float du = dist[u];
+        cg.forEachNeighbor(u, [&](int v, float w) {
+            if (closed[v]) return;
+            float alt = du + w;
+            if (alt < dist[v]) {
+                dist[v] = alt;
+                parent[v] = u;
+                open.push({alt, v});
+            }
+        });
+    }
+    auto t1 = chrono::high_resolution_clock::now();
+    stats.ms = chrono::duration<double, milli>(t1 - t0).count();
+    stats.pathCost = dist[goal];
+
+    vector<int> path;
+    if (dist[goal] == INFINITY) return path;
+    for (int v = goal; v != -1; v = parent[v]) path.push_back(cg.origId[v]);
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+// ====================== Memory Accounting ======================
+// Estimated heap footprint of the map-of-vectors adjacency: each map entry is
+// a hash node (key + vector + next pointer) plus a bucket slot.
+size_t map_adjacency_bytes(const Graph& g) {
+    size_t b = g.adj.bucket_count() * sizeof(void*);
+    for (auto& [u, es] : g.adj)
+        b += sizeof(void*) + sizeof(int) + sizeof(vector<Edge>) + es.capacity() * sizeof(Edge);
+    return b;
+}
+
+// ====================== MAIN ======================
+int main(int argc, char** argv) {
+    string nodesFile = "../dijkstra/nodes.csv", edgesFile = "../dijkstra/edges.csv";
+    int queries = 200;
+    uint64_t seed = 42;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string a = argv[i];
+        if (a == "--nodes") nodesFile = argv[i + 1];
+        else if (a == "--edges") edgesFile = argv[i + 1];
+        else if (a == "--queries") queries = stoi(argv[i + 1]);
+        else if (a == "--seed") seed = stoull(argv[i + 1]);
+    }
+
+    Graph g;
+    if (nodesFile != "-") load_nodes(g, nodesFile);
+    load_edges(g, edgesFile);
+
+    auto t0 = chrono::high_resolution_clock::now();
+    CompressedGraph cg;
+    cg.build(g);
+    auto t1 = chrono::high_resolution_clock::now();
+
+    size_t halfEdges = 0;
+    for (auto& [u, es] : g.adj) halfEdges += es.size();
+    const size_t N = g.nodes.size(), n = cg.nodeCount();
+    size_t mapBytes  = map_adjacency_bytes(g);
+    size_t csrBytes  = (n + 1) * sizeof(uint32_t) + halfEdges * (sizeof(int) + sizeof(float));
+    size_t p3Bytes   = halfEdges * sizeof(pair<int,double>);
+    size_t compBytes = cg.memoryBytes();
+
+    cout << fixed << setprecision(2);
+    cout << "Graph: " << n << " nodes (" << N << " id slots), " << halfEdges << " half-edges\n";
+    cout << "Encoding: " << cg.weightBytes << "-byte weights"
+         << (cg.weightScale != 1.0f ? " (quantized, max error " + to_string(cg.maxQuantError) + ")" : " (exact)")
+         << ", built in " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "Adjacency memory:\n";
+    cout << "  Part-2 map<int, vector<Edge>> : " << setw(12) << mapBytes << " B  ("
+         << (double)mapBytes / max<size_t>(halfEdges, 1) << " B/half-edge)\n";
+    cout << "  Part-3 pair<int,double> lists : " << setw(12) << p3Bytes << " B  (payload only)\n";
+    cout << "  plain CSR int + float        : " << setw(12) << csrBytes << " B\n";
+    cout << "  compressed                   : " << setw(12) << compBytes << " B  (ids + offsets "
+         << cg.origId.size() * sizeof(int) + cg.offset.size() * sizeof(uint32_t) << " B + lists "
+         << cg.bytes.size() << " B = "
+         << (double)cg.bytes.size() / max<size_t>(halfEdges, 1) << " B/half-edge)\n";
+    cout << "  Part-2 / compressed          : " << setw(12) << (double)mapBytes / max<size_t>(compBytes, 1)
+         << "x\n";
+
+    // Same random queries on both layouts; costs must agree (exactly when the
+    // weights were stored without quantization), and the compressed path must
+    // run start -> goal over real edges at the cost it reports.
+    vector<int> valid;
+    for (size_t i = 0; i < N; ++i)
+        if (g.adj.count(i)) valid.push_back(i);
+    if (valid.empty()) return 0;
+    mt19937_64 rng(seed);
+    uniform_int_distribution<size_t> pick(0, valid.size() - 1);
+    double msMap = 0, msComp = 0;
+    int mismatches = 0;
+    for (int q = 0; q < queries; ++q) {
+        int s = valid[pick(rng)], t = valid[pick(rng)];
+        DijkstraStats a, b;
+        auto exact = dijkstra(g, s, t, a);
+        auto path = dijkstra(cg, s, t, b);
+        msMap += a.ms;
+        msComp += b.ms;
+        float ca = a.pathCost, cb = b.pathCost;
+        // Each edge is off by at most maxQuantError, so the two optima differ
+        // by at most that much per edge of the longer of the two paths.
+        float tol = cg.maxQuantError * (float)max(exact.size(), path.size()) + 1e-3f;
+        bool ok = isfinite(ca) == isfinite(cb) && (!isfinite(ca) || fabs(ca - cb) <= tol);
+        if (ok && isfinite(cb))
+            ok = path.front() == s && path.back() == t &&
+                 fabs(path_cost(g, path) - cb) <= cg.maxQuantError * (float)path.size() + 1e-3f;
+        if (!ok) mismatches++;
+    }
+    cout << setprecision(3);
+    cout << "Dijkstra over " << queries << " queries: map " << msMap / queries << " ms/query, compressed "
+         << msComp / queries << " ms/query | cost mismatches: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
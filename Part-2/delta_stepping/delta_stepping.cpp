@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../dijkstra/dijkstra.h"
+
+using namespace std;
+
+// Parallel delta-stepping single-source shortest paths (Meyer & Sanders) over
+// the Part-2 Graph, for one-to-all workloads. Nodes are kept in buckets of
+// width delta. Each bucket is settled by repeated parallel relaxation of light
+// edges (w <= delta); heavy edges are then relaxed once from the nodes it
+// settled. The output dist[] is checked against a one-to-all dijkstra().
+//
+// Usage: delta_stepping [--nodes nodes.csv] [--edges edges.csv] [--delta D]
+//                       [--sources N] [--threads 1,2,4,...] [--seed S]
+
+// ====================== Delta-Stepping ======================
+// Reusable barrier for the worker pool (phases are short, so a mutex + cv
+// is enough; the search does a few thousand phases on roadNet-CA).
+class Barrier {
+public:
+    explicit Barrier(int n) : count(n), waiting(0), generation(0) {}
+    void wait() {
+        unique_lock<mutex> lock(m);
+        int gen = generation;
+        if (++waiting == count) {
+            waiting = 0;
+            generation++;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return gen != generation; });
+        }
+    }
+private:
+    mutex m;
+    condition_variable cv;
+    int count, waiting, generation;
+};
+
+// CSR copy of the Graph with each node's light edges (w <= delta) first.
+struct SplitCsr {
+    vector<int> start, mid;     // light edges in [start[u], mid[u]), heavy in [mid[u], start[u+1])
+    vector<int> to;
+    vector<float> w;
+
+    void build(const Graph& g, float delta) {
+        const int N = g.nodes.size();
+        start.assign(N + 1, 0);
+        for (auto& [u, es] : g.adj) start[u + 1] = es.size();
+        for (int u = 0; u < N; ++u) start[u + 1] += start[u];
+        mid.assign(start.begin(), start.end() - 1);   // nodes without edges: empty ranges
+        to.resize(start[N]);
+        w.resize(start[N]);
+        for (auto& [u, es] : g.adj) {
+            int lo = start[u], hi = start[u + 1];
+            for (auto& e : es) {
+                int slot = e.w <= delta ? lo++ : --hi;
+                to[slot] = e.to;
+                w[slot] = e.w;
+            }
+            mid[u] = lo;
+        }
+    }
+};
+
+struct DeltaStats {
+    size_t buckets = 0, lightPhases = 0, heavyPhases = 0, relaxations = 0;
+    double ms = 0.0;
+};
+
+// The pool's threads are started once and parked at the barrier between
+// searches; run() hands them a source, so per-source timing covers only the
+// search, not thread start-up.
+class DeltaStepper {
+public:
+    DeltaStepper(const SplitCsr& csr, int N, float delta, int threads)
+        : csr(csr), N(N), delta(delta), threads(threads), dist(N), local(threads),
+          frontierStamp(N, -1), settledStamp(N), relaxCount(threads), barrier(threads) {
+        for (int t = 1; t < threads; ++t) pool.emplace_back([this, t] { park(t); });
+    }
+    ~DeltaStepper() {
+        stop = true;
+        barrier.wait();
+        for (auto& th : pool) th.join();
+    }
+
+    vector<float> run(int source, DeltaStats& st) {
+        for (auto& d : dist) d.store(INFINITY, memory_order_relaxed);
+        dist[source].store(0.0f, memory_order_relaxed);
+        for (auto& lb : local) lb.clear();
+        local[0].resize(1);
+        local[0][0].push_back(source);
+        settled.clear();
+        fill(settledStamp.begin(), settledStamp.end(), -1);
+        fill(relaxCount.begin(), relaxCount.end(), 0);
+        mode = LIGHT;
+        cur = 0;
+        stats = &st;
+
+        auto t0 = chrono::high_resolution_clock::now();
+        st.buckets = 1;
+        barrier.wait();   // release the pool
+        work(0);
+        barrier.wait();   // every thread has seen DONE
+        auto t1 = chrono::high_resolution_clock::now();
+        st.ms = chrono::duration<double, milli>(t1 - t0).count();
+        for (size_t c : relaxCount) st.relaxations += c;
+
+        vector<float> out(N);
+        for (int i = 0; i < N; ++i) out[i] = dist[i].load(memory_order_relaxed);
+        return out;
+    }
+
+private:
+    enum Mode { LIGHT, HEAVY, DONE };
+    const SplitCsr& csr;
+    const int N;
+    const float delta;
+    const int threads;
+    vector<atomic<float>> dist;
+    // Relaxations land in the relaxing thread's own buckets; between phases the
+    // coordinator (thread 0) merges bucket `cur` into the shared frontier.
+    vector<vector<vector<int>>> local;
+    vector<int> frontier, settled;
+    vector<int> frontierStamp, settledStamp;   // frontierStamp keys on phase, which never resets
+    vector<size_t> relaxCount;
+    Mode mode = DONE;
+    size_t cur = 0;
+    int phase = 0;
+    bool stop = false;
+    DeltaStats* stats = nullptr;
+    Barrier barrier;
+    vector<thread> pool;
+
+    void park(int t) {
+        for (;;) {
+            barrier.wait();
+            if (stop) return;
+            work(t);
+            barrier.wait();
+        }
+    }
+
+    void relax(int t, int v, float nd) {
+        float old = dist[v].load(memory_order_relaxed);
+        while (nd < old)
+            if (dist[v].compare_exchange_weak(old, nd, memory_order_relaxed)) {
+                size_t b = (size_t)(nd / delta);
+                auto& lb = local[t];
+                if (lb.size() <= b) lb.resize(b + 1);
+                lb[b].push_back(v);
+                return;
+            }
+    }
+
+    // Serial step between phases: choose the next frontier and mode.
+    void schedule() {
+        for (;;) {
+            frontier.clear();
+            phase++;
+            for (auto& lb : local) {
+                if (lb.size() <= cur) continue;
+                for (int v : lb[cur]) {
+                    // Skip duplicates and entries whose dist has since dropped to an earlier bucket.
+                    if (frontierStamp[v] == phase) continue;
+                    if ((size_t)(dist[v].load(memory_order_relaxed) / delta) != cur) continue;
+                    frontierStamp[v] = phase;
+                    frontier.push_back(v);
+                }
+                lb[cur].clear();
+            }
+            if (!frontier.empty()) {
+                for (int v : frontier)
+                    if (settledStamp[v] != (int)cur) { settledStamp[v] = (int)cur; settled.push_back(v); }
+                mode = LIGHT;
+                stats->lightPhases++;
+                return;
+            }
+            if (!settled.empty()) {
+                frontier.swap(settled);
+                settled.clear();
+                mode = HEAVY;
+                stats->heavyPhases++;
+                return;
+            }
+            // Bucket cur is finished; advance to the next non-empty one.
+            size_t next = SIZE_MAX;
+            for (auto& lb : local)
+                for (size_t b = cur + 1; b < lb.size() && b < next; ++b)
+                    if (!lb[b].empty()) { next = b; break; }
+            if (next == SIZE_MAX) { mode = DONE; return; }
+            cur = next;
+            stats->buckets++;
+        }
+    }
+
+    void work(int t) {
+        for (;;) {
+            if (t == 0) schedule();
+            barrier.wait();
+            if (mode == DONE) return;
+            size_t n = frontier.size();
+            size_t b = n * t / threads, e = n * (t + 1) / threads;
+            for (size_t i = b; i < e; ++i) {
+                int u = frontier[i];
+                float du = dist[u].load(memory_order_relaxed);
+                int lo = mode == LIGHT ? csr.start[u] : csr.mid[u];
+                int hi = mode == LIGHT ? csr.mid[u] : csr.start[u + 1];
+                for (int k = lo; k < hi; ++k) relax(t, csr.to[k], du + csr.w[k]);
+                relaxCount[t] += hi - lo;
+            }
+            barrier.wait();
+        }
+    }
+};
+
+// Bucket width: with integer weights 1..20 (build_large_graph) and road-like
+// degree ~3, delta near maxW / avgDegree keeps buckets wide enough to give
+// each phase parallel work without many re-relaxations.
+float default_delta(const Graph& g) {
+    size_t halfEdges = 0, withEdges = 0;
+    float maxW = 0.0f, minW = INFINITY;
+    for (auto& [u, es] : g.adj) {
+        halfEdges += es.size();
+        withEdges++;
+        for (auto& e : es) { maxW = max(maxW, e.w); minW = min(minW, e.w); }
+    }
+    if (!halfEdges) return 1.0f;
+    float avgDeg = (float)halfEdges / withEdges;
+    return max(minW, ceil(maxW / max(avgDeg, 1.0f)));
+}
+
+// ====================== MAIN ======================
+int main(int argc, char** argv) {
+    string nodesFile = "../dijkstra/nodes.csv", edgesFile = "../dijkstra/edges.csv";
+    float delta = 0.0f;
+    int sources = 5;
+    uint64_t seed = 42;
+    vector<int> threadCounts = {1, 2, 4, 8, 16, 32};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string a = argv[i];
+        if (a == "--nodes") nodesFile = argv[i + 1];
+        else if (a == "--edges") edgesFile = argv[i + 1];
+        else if (a == "--delta") delta = stof(argv[i + 1]);
+        else if (a == "--sources") sources = stoi(argv[i + 1]);
+        else if (a == "--seed") seed = stoull(argv[i + 1]);
+        else if (a == "--threads") {
+            threadCounts.clear();
+            stringstream ss(argv[i + 1]);
+            for (string tok; getline(ss, tok, ',');) if (!tok.empty()) threadCounts.push_back(stoi(tok));
+        }
+    }
+
+    Graph g;
+    if (nodesFile != "-") load_nodes(g, nodesFile);
+    load_edges(g, edgesFile);
+    const int N = g.nodes.size();
+    if (delta <= 0.0f) delta = default_delta(g);
+
+    SplitCsr csr;
+    csr.build(g, delta);
+
+    vector<int> valid;
+    for (int i = 0; i < N; ++i) if (g.adj.count(i)) valid.push_back(i);
+    if (valid.empty()) { cerr << "Error: graph has no edges" << endl; return 1; }
+    mt19937_64 rng(seed);
+    uniform_int_distribution<size_t> pick(0, valid.size() - 1);
+    vector<int> srcs;
+    for (int i = 0; i < sources; ++i) srcs.push_back(valid[pick(rng)]);
+
+    cout << fixed << setprecision(3);
+    cout << "Graph: " << N << " node slots, " << csr.to.size() << " half-edges | delta " << delta
+         << " | hardware threads " << thread::hardware_concurrency() << "\n";
+
+    // Reference distances, also timed as the sequential baseline.
+    vector<vector<float>> ref;
+    double dijkstraMs = 0;
+    for (int s : srcs) {
+        auto t0 = chrono::high_resolution_clock::now();
+        ref.push_back(dijkstra_all(g, s));
+        dijkstraMs += chrono::duration<double, milli>(chrono::high_resolution_clock::now() - t0).count();
+    }
+    dijkstraMs /= srcs.size();
+    cout << "dijkstra one-to-all: " << dijkstraMs << " ms/source\n\n";
+    cout << setw(8) << "threads" << setw(12) << "ms/source" << setw(10) << "speedup" << setw(12)
+         << "vs dijkstra" << setw(10) << "buckets" << setw(10) << "phases" << setw(14) << "relaxations"
+         << setw(10) << "match" << "\n";
+
+    double baseMs = 0;
+    bool allMatch = true;
+    for (int T : threadCounts) {
+        DeltaStepper stepper(csr, N, delta, max(1, T));
+        double ms = 0;
+        DeltaStats last;
+        bool match = true;
+        for (size_t i = 0; i < srcs.size(); ++i) {
+            DeltaStats st;
+            auto dist = stepper.run(srcs[i], st);
+            ms += st.ms;
+            last = st;
+            for (int v = 0; v < N && match; ++v) {
+                float a = ref[i][v], b = dist[v];
+                if (isinf(a) != isinf(b) || (!isinf(a) && fabs(a - b) > 1e-4f * max(1.0f, a))) match = false;
+            }
+        }
+        ms /= srcs.size();
+        if (baseMs == 0) baseMs = ms;
+        allMatch = allMatch && match;
+        cout << setw(8) << T << setw(12) << ms << setw(10) << baseMs / ms << setw(12) << dijkstraMs / ms
+             << setw(10) << last.buckets << setw(10) << last.lightPhases + last.heavyPhases
+             << setw(14) << last.relaxations << setw(10) << (match ? "yes" : "NO") << "\n";
+    }
+    return allMatch ? 0 : 1;
+}
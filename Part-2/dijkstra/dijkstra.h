@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/road_graph.h"
+#include "../common/search_instrumentation.h"
+#include "../common/spatial_index.h"
+
+using namespace std;
+
+// Dijkstra engine: included by dijkstra.cpp and by the benchmark, so both
+// time the same code.
+
+// ====================== Dijkstra ======================
+struct DijkstraStats {
+    size_t expansions = 0;
+    size_t maxFringe  = 0;
+    double ms         = 0.0;
+    float  pathCost   = INFINITY;
+    bool   rejected   = false;   // refused up front by the reachability filter
+    SearchCounters counters;
+    HwCounters hw;
+};
+
+inline vector<int> dijkstra(const Graph& g, int start, int goal, DijkstraStats& stats) {
+    if (!g.reach.mayReach(start, goal)) { stats.rejected = true; return {}; }
+    const int N = g.nodes.size();
+    vector<float> dist(N, INFINITY);
+    vector<int> parent(N, -1);
+    vector<char> closed(N, 0);
+
+    using PQItem = pair<float,int>;
+    priority_queue<PQItem, vector<PQItem>, greater<PQItem>> open;
+    dist[start] = 0.0f;
+    open.push({0.0f, start});
+    COUNT(pushes, 1);
+
+    PerfScope perf(stats.hw);
+    perf.start();
+    auto t0 = chrono::high_resolution_clock::now();
+
+    while (!open.empty()) {
+        stats.maxFringe = max(stats.maxFringe, open.size());
+        int u = open.top().second; open.pop();
+        COUNT(pops, 1);
+        COUNT(bytesTouched, sizeof(PQItem) + sizeof(char));
+        if (closed[u]) { COUNT(stalePops, 1); continue; }
+        closed[u] = 1;
+        stats.expansions++;
+
+        if (u == goal) break;
+
+        auto it = g.adj.find(u);
+        if (it == g.adj.end()) continue;
+
+        for (const auto& e : it->second) {
+            COUNT(relaxations, 1);
+            COUNT(bytesTouched, sizeof(Edge) + sizeof(char));
+            if (closed[e.to]) continue;
+            float alt = dist[u] + e.w;
+            COUNT(bytesTouched, sizeof(float));
+            if (alt < dist[e.to]) {
+                dist[e.to] = alt;
+                parent[e.to] = u;
+                open.push({alt, e.to});
+                COUNT(decreases, 1);
+                COUNT(pushes, 1);
+                COUNT(bytesTouched, sizeof(float) + sizeof(int) + sizeof(PQItem));
+            }
+        }
+    }
+
+    auto t1 = chrono::high_resolution_clock::now();
+    perf.stop();
+    stats.ms = chrono::duration<double, milli>(t1 - t0).count();
+    stats.pathCost = dist[goal];
+
+    if (parent[goal] == -1 && start != goal) return {};
+
+    vector<int> path;
+    for (int v = goal; v != -1; v = parent[v]) {
+        path.push_back(v);
+        if (v == start) break;
+    }
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+inline vector<int> dijkstra(const Graph& g, const string& startName, const string& goalName, DijkstraStats& stats) {
+    int start = g.findId(startName);
+    int goal  = g.findId(goalName);
+    if (start < 0 || goal < 0) {
+        cerr << "Unknown start/goal: " << startName << " -> " << goalName << endl;
+        return {};
+    }
+    return dijkstra(g, start, goal, stats);
+}
+
+// Routes between arbitrary coordinates by snapping both ends to the nearest node.
+inline vector<int> dijkstra(const Graph& g, const KdTree& index, float sx, float sy, float gx, float gy,
+                            DijkstraStats& stats) {
+    int start = index.nearest(sx, sy);
+    int goal  = index.nearest(gx, gy);
+    if (start < 0 || goal < 0) return {};
+    return dijkstra(g, start, goal, stats);
+}
+
+// Part-2 dijkstra() without a goal: runs until the queue is empty. The
+// reference the parallel and batched engines are checked against.
+inline vector<float> dijkstra_all(const Graph& g, int start) {
+    const int N = g.nodes.size();
+    vector<float> dist(N, INFINITY);
+    vector<char> closed(N, 0);
+    using PQItem = pair<float,int>;
+    priority_queue<PQItem, vector<PQItem>, greater<PQItem>> open;
+    dist[start] = 0.0f;
+    open.push({0.0f, start});
+    while (!open.empty()) {
+        int u = open.top().second; open.pop();
+        if (closed[u]) continue;
+        closed[u] = 1;
+        auto it = g.adj.find(u);
+        if (it == g.adj.end()) continue;
+        for (const auto& e : it->second) {
+            if (closed[e.to]) continue;
+            float alt = dist[u] + e.w;
+            if (alt < dist[e.to]) {
+                dist[e.to] = alt;
+                open.push({alt, e.to});
+            }
+        }
+    }
+    return dist;
+}
+
+// ====================== Multi-goal ======================
+// "Nearest of many targets" in one pass: the search runs until k targets are
+// settled. Targets are settled in order of distance, so the hits come out
+// nearest first with exact costs, and one search replaces one per target.
+
+inline vector<TargetHit> dijkstra_nearest(const Graph& g, int start, const vector<int>& targets, size_t k,
+                                          DijkstraStats& stats) {
+    const int N = g.nodes.size();
+    vector<float> dist(N, INFINITY);
+    vector<int> parent(N, -1);
+    vector<char> closed(N, 0), isTarget(N, 0);
+    size_t remaining = 0;
+    for (int t : targets)
+        if (t >= 0 && t < N && !isTarget[t] && g.reach.mayReach(start, t)) { isTarget[t] = 1; remaining++; }
+    k = min(k, remaining);
+
+    using PQItem = pair<float,int>;
+    priority_queue<PQItem, vector<PQItem>, greater<PQItem>> open;
+    dist[start] = 0.0f;
+    open.push({0.0f, start});
+    COUNT(pushes, 1);
+
+    PerfScope perf(stats.hw);
+    perf.start();
+    auto t0 = chrono::high_resolution_clock::now();
+
+    vector<TargetHit> hits;
+    while (!open.empty() && hits.size() < k) {
+        stats.maxFringe = max(stats.maxFringe, open.size());
+        int u = open.top().second; open.pop();
+        COUNT(pops, 1);
+        COUNT(bytesTouched, sizeof(PQItem) + sizeof(char));
+        if (closed[u]) { COUNT(stalePops, 1); continue; }
+        closed[u] = 1;
+        stats.expansions++;
+
+        if (isTarget[u]) {
+            hits.push_back({u, dist[u], {}});
+            if (hits.size() == k) break;
+        }
+
+        auto it = g.adj.find(u);
+        if (it == g.adj.end()) continue;
+
+        for (const auto& e : it->second) {
+            COUNT(relaxations, 1);
+            COUNT(bytesTouched, sizeof(Edge) + sizeof(char));
+            if (closed[e.to]) continue;
+            float alt = dist[u] + e.w;
+            COUNT(bytesTouched, sizeof(float));
+            if (alt < dist[e.to]) {
+                dist[e.to] = alt;
+                parent[e.to] = u;
+                open.push({alt, e.to});
+                COUNT(decreases, 1);
+                COUNT(pushes, 1);
+                COUNT(bytesTouched, sizeof(float) + sizeof(int) + sizeof(PQItem));
+            }
+        }
+    }
+
+    auto t1 = chrono::high_resolution_clock::now();
+    perf.stop();
+    stats.ms = chrono::duration<double, milli>(t1 - t0).count();
+    stats.pathCost = hits.empty() ? INFINITY : hits.front().cost;
+
+    for (auto& hit : hits) {
+        for (int v = hit.target; v != -1; v = parent[v]) {
+            hit.path.push_back(v);
+            if (v == start) break;
+        }
+        reverse(hit.path.begin(), hit.path.end());
+    }
+    return hits;
+}
+
+inline vector<TargetHit> dijkstra_nearest(const Graph& g, const string& startName, const vector<string>& targetNames,
+                                          size_t k, DijkstraStats& stats) {
+    int start = g.findId(startName);
+    if (start < 0) {
+        cerr << "Unknown start: " << startName << endl;
+        return {};
+    }
+    vector<int> targets;
+    for (const auto& name : targetNames) {
+        int id = g.findId(name);
+        if (id < 0) cerr << "Unknown target: " << name << endl;
+        else targets.push_back(id);
+    }
+    return dijkstra_nearest(g, start, targets, k, stats);
+}
+
+inline string stats_json(const DijkstraStats& s) {
+    ostringstream os;
+    os << "{\"expansions\":" << s.expansions << ",\"max_fringe\":" << s.maxFringe
+       << ",\"ms\":" << s.ms << ",\"path_cost\":"
+       << (isfinite(s.pathCost) ? to_string(s.pathCost) : string("null"))
+       << "," << counters_json(s.counters, s.hw) << "}";
+    return os.str();
+}
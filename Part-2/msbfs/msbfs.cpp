@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "../dijkstra/dijkstra.h"
+
+using namespace std;
+
+// Multi-source BFS (MS-BFS, Then et al.): up to 64 or 256 unweighted BFS runs
+// share one traversal. Every node carries a bitmask with one bit per source;
+// a level ORs each frontier node's mask into its neighbours, so a node or
+// edge shared by many searches is touched once rather than once per source.
+// Levels switch to bottom-up when the frontier gets large (see ms_bfs).
+// Outputs per-source hop distances (--hops) or reach sets (--reach), and
+// compares the time against one BFS per source and one dijkstra_all().
+// Only worthwhile on small-diameter graphs: on road networks and grids it
+// runs at or below the speed of one BFS per source.
+//
+// Usage: msbfs [--nodes nodes.csv] [--edges edges.csv] [--sources N] [--width 64|256]
+//              [--hops FILE] [--reach FILE] [--seed S]
+
+// ====================== CSR ======================
+// Targets only; BFS ignores weights. The transpose (in-edges) serves the
+// bottom-up levels of ms_bfs.
+struct Csr {
+    vector<int> start, to;
+    vector<int> inStart, from;
+
+    void build(const Graph& g) {
+        const int N = g.nodes.size();
+        start.assign(N + 1, 0);
+        inStart.assign(N + 1, 0);
+        for (auto& [u, es] : g.adj) {
+            start[u + 1] = es.size();
+            for (auto& e : es) inStart[e.to + 1]++;
+        }
+        for (int u = 0; u < N; ++u) {
+            start[u + 1] += start[u];
+            inStart[u + 1] += inStart[u];
+        }
+        to.resize(start[N]);
+        from.resize(inStart[N]);
+        vector<int> fill(inStart.begin(), inStart.end() - 1);
+        for (auto& [u, es] : g.adj) {
+            int k = start[u];
+            for (auto& e : es) {
+                to[k++] = e.to;
+                from[fill[e.to]++] = u;
+            }
+        }
+    }
+};
+
+// Plain single-source BFS, the per-source baseline.
+void bfs(const Csr& csr, int source, vector<int>& hops, vector<int>& queue) {
+    fill(hops.begin(), hops.end(), -1);
+    queue.clear();
+    hops[source] = 0;
+    queue.push_back(source);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        for (int k = csr.start[u]; k < csr.start[u + 1]; ++k) {
+            int v = csr.to[k];
+            if (hops[v] < 0) { hops[v] = hops[u] + 1; queue.push_back(v); }
+        }
+    }
+}
+
+// ====================== Source masks ======================
+// One bit per source. The 256-bit masks use AVX2 when the build enables it
+// (-mavx2 / -march=native); otherwise the word loops are left to the
+// compiler's vectorizer.
+template <size_t Words>
+struct Mask {
+    uint64_t w[Words] = {};
+};
+
+template <size_t Words>
+inline bool and_not_any(const Mask<Words>& a, const Mask<Words>& b, Mask<Words>& out) {   // out = a & ~b
+#if defined(__AVX2__)
+    if constexpr (Words == 4) {
+        __m256i x = _mm256_andnot_si256(_mm256_loadu_si256((const __m256i*)b.w),
+                                        _mm256_loadu_si256((const __m256i*)a.w));
+        _mm256_storeu_si256((__m256i*)out.w, x);
+        return !_mm256_testz_si256(x, x);
+    }
+#endif
+    uint64_t any = 0;
+    for (size_t i = 0; i < Words; ++i) { out.w[i] = a.w[i] & ~b.w[i]; any |= out.w[i]; }
+    return any != 0;
+}
+
+template <size_t Words>
+inline void or_into(Mask<Words>& dst, const Mask<Words>& src) {
+#if defined(__AVX2__)
+    if constexpr (Words == 4) {
+        _mm256_storeu_si256((__m256i*)dst.w, _mm256_or_si256(_mm256_loadu_si256((const __m256i*)dst.w),
+                                                             _mm256_loadu_si256((const __m256i*)src.w)));
+        return;
+    }
+#endif
+    for (size_t i = 0; i < Words; ++i) dst.w[i] |= src.w[i];
+}
+
+// ====================== MS-BFS ======================
+struct MsBfsStats {
+    int levels = 0;
+    int bottomUpLevels = 0;
+    size_t edgeVisits = 0;
+    double ms = 0.0;
+};
+
+// Direction switch, after Beamer et al. but costed for masks: a bottom-up
+// level scans the in-edges of every node still missing some source and can
+// only stop early once all its missing bits arrive, so it is chosen when the
+// frontier's out-edges exceed 1/BOTTOM_UP_ALPHA of those in-edges and the
+// frontier holds over 1/BOTTOM_UP_BETA of the nodes.
+constexpr size_t BOTTOM_UP_ALPHA = 2;
+constexpr size_t BOTTOM_UP_BETA = 4;
+
+// Runs BFS from up to 64 * Words sources at once. seen[v] ends up as the set
+// of sources that reach v. If hops is non-null it receives hop distances
+// source-major (hops[i * N + v], 0xFFFF = unreached).
+//
+// Top-down levels push each frontier mask along out-edges. Bottom-up levels
+// instead let every node still missing some source pull the masks of its
+// in-neighbours, which pays off when the frontier covers much of the graph
+// (small-diameter graphs). Road networks and grids have long diameters and
+// thin frontiers, so they stay top-down. There the sources rarely share a
+// level, every node is still visited once per distinct arrival level, and
+// each visit costs a mask: MS-BFS is no faster than one BFS per source on
+// such graphs and is not the engine to use for them.
+template <size_t Words>
+MsBfsStats ms_bfs(const Csr& csr, const vector<int>& sources, vector<Mask<Words>>& seen, uint16_t* hops) {
+    using M = Mask<Words>;
+    const int N = csr.start.size() - 1;
+    MsBfsStats stats;
+    auto t0 = chrono::high_resolution_clock::now();
+
+    seen.assign(N, M{});
+    vector<M> visit(N), next(N);
+    vector<int> frontier, nextFrontier;
+    vector<char> queued(N, 0);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        int s = sources[i];
+        seen[s].w[i / 64] |= 1ull << (i % 64);
+        visit[s].w[i / 64] |= 1ull << (i % 64);
+        if (!queued[s]) { queued[s] = 1; frontier.push_back(s); }
+        if (hops) hops[i * N + s] = 0;
+    }
+    for (int v : frontier) queued[v] = 0;
+
+    M all;                                             // one bit per source in this call
+    for (size_t i = 0; i < sources.size(); ++i) all.w[i / 64] |= 1ull << (i % 64);
+    M fresh, missing;
+    size_t unfinishedEdges = csr.from.size();
+    auto finish = [&](int v) {
+        if (!and_not_any(all, seen[v], missing)) unfinishedEdges -= csr.inStart[v + 1] - csr.inStart[v];
+    };
+    for (int s : frontier) finish(s);
+
+    while (!frontier.empty()) {
+        stats.levels++;
+        size_t frontierEdges = 0;
+        for (int u : frontier) frontierEdges += csr.start[u + 1] - csr.start[u];
+        if (frontierEdges * BOTTOM_UP_ALPHA > unfinishedEdges && frontier.size() * BOTTOM_UP_BETA > (size_t)N) {
+            stats.bottomUpLevels++;
+            for (int v = 0; v < N; ++v) {
+                if (!and_not_any(all, seen[v], missing)) continue;
+                M& got = next[v];
+                bool found = false;
+                int k = csr.inStart[v];
+                for (; k < csr.inStart[v + 1]; ++k) {
+                    if (!and_not_any(visit[csr.from[k]], seen[v], fresh)) continue;
+                    or_into(got, fresh);
+                    found = true;
+                    if (!and_not_any(missing, got, fresh)) { ++k; break; }
+                }
+                stats.edgeVisits += k - csr.inStart[v];
+                if (found) {
+                    or_into(seen[v], got);
+                    finish(v);
+                    nextFrontier.push_back(v);
+                }
+            }
+        } else {
+            for (int u : frontier) {
+                const M& m = visit[u];
+                for (int k = csr.start[u]; k < csr.start[u + 1]; ++k) {
+                    int v = csr.to[k];
+                    if (!and_not_any(m, seen[v], fresh)) continue;
+                    or_into(next[v], fresh);
+                    or_into(seen[v], fresh);
+                    finish(v);
+                    if (!queued[v]) { queued[v] = 1; nextFrontier.push_back(v); }
+                }
+                stats.edgeVisits += csr.start[u + 1] - csr.start[u];
+            }
+        }
+        if (hops)
+            for (int v : nextFrontier)
+                for (size_t j = 0; j < Words; ++j)
+                    for (uint64_t bits = next[v].w[j]; bits; bits &= bits - 1)
+                        hops[(j * 64 + __builtin_ctzll(bits)) * N + v] = (uint16_t)stats.levels;
+        for (int u : frontier) visit[u] = M{};
+        swap(visit, next);
+        frontier.swap(nextFrontier);
+        nextFrontier.clear();
+        for (int v : frontier) queued[v] = 0;
+    }
+
+    stats.ms = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - t0).count();
+    return stats;
+}
+
+// ====================== Runner ======================
+// Sources are processed in chunks of the mask width. Hop and reach files
+// start with uint32 sourceCount, uint32 N and the int32 source ids, then
+// hold uint16 hops[source][node] or, per chunk, one mask of width/8 bytes
+// per node.
+template <size_t Words>
+int run(const Graph& g, const Csr& csr, const vector<int>& sources, const string& hopsFile,
+        const string& reachFile) {
+    const int N = csr.start.size() - 1;
+    const size_t width = 64 * Words;
+    ofstream hopsOut, reachOut;
+    auto header = [&](ofstream& out, const string& file) {
+        out.open(file, ios::binary);
+        uint32_t s = sources.size(), n = N;
+        out.write((const char*)&s, 4);
+        out.write((const char*)&n, 4);
+        out.write((const char*)sources.data(), sources.size() * sizeof(int));
+    };
+    if (!hopsFile.empty()) header(hopsOut, hopsFile);
+    if (!reachFile.empty()) header(reachOut, reachFile);
+
+    // Weighted one-to-all from a single source, for scale.
+    auto t0 = chrono::high_resolution_clock::now();
+    dijkstra_all(g, sources[0]);
+    double dijkstraMs = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - t0).count();
+
+    double msbfsMs = 0, bfsMs = 0;
+    size_t edgeVisits = 0, mismatches = 0;
+    int maxLevels = 0, bottomUpLevels = 0;
+    vector<Mask<Words>> seen;
+    vector<uint16_t> hops;
+    vector<int> single(N), queue;
+    for (size_t c = 0; c < sources.size(); c += width) {
+        vector<int> chunk(sources.begin() + c, sources.begin() + min(sources.size(), c + width));
+        if (hopsOut.is_open()) hops.assign(chunk.size() * (size_t)N, 0xFFFF);
+        auto st = ms_bfs<Words>(csr, chunk, seen, hopsOut.is_open() ? hops.data() : nullptr);
+        msbfsMs += st.ms;
+        edgeVisits += st.edgeVisits;
+        maxLevels = max(maxLevels, st.levels);
+        bottomUpLevels += st.bottomUpLevels;
+
+        // One BFS per source: timed as the baseline and used to check the
+        // reach sets (and hops, when they were recorded).
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            auto b0 = chrono::high_resolution_clock::now();
+            bfs(csr, chunk[i], single, queue);
+            bfsMs += chrono::duration<double, milli>(chrono::high_resolution_clock::now() - b0).count();
+            for (int v = 0; v < N; ++v) {
+                bool reached = (seen[v].w[i / 64] >> (i % 64)) & 1;
+                if (reached != (single[v] >= 0)) { mismatches++; break; }
+                if (!hops.empty() && reached && hops[i * (size_t)N + v] != single[v]) { mismatches++; break; }
+            }
+        }
+        if (hopsOut.is_open()) hopsOut.write((const char*)hops.data(), hops.size() * sizeof(uint16_t));
+        if (reachOut.is_open()) reachOut.write((const char*)seen.data(), seen.size() * sizeof(Mask<Words>));
+    }
+
+    const double S = sources.size();
+    cout << "dijkstra_all x1:           " << setw(10) << dijkstraMs << " ms\n";
+    cout << "bfs x" << setw(4) << left << sources.size() << right << ":                " << setw(10) << bfsMs
+         << " ms (" << bfsMs / S << " ms/source)\n";
+    cout << "ms-bfs width " << setw(3) << width << " x" << setw(4) << left << sources.size() << right << ":"
+         << setw(10) << msbfsMs << " ms (" << msbfsMs / S << " ms/source, " << maxLevels << " levels, "
+         << edgeVisits << " edge visits, " << bottomUpLevels << " bottom-up)\n";
+    cout << "speedup vs bfs: " << bfsMs / max(msbfsMs, 1e-9) << "x | cost in single BFS runs: "
+         << msbfsMs / max(bfsMs / S, 1e-9) << " | in dijkstra_all runs: " << msbfsMs / max(dijkstraMs, 1e-9)
+         << "\n";
+    cout << (mismatches ? "MISMATCH against per-source BFS: " + to_string(mismatches) + " sources\n"
+                        : string("All sources match per-source BFS.\n"));
+    if (hopsOut.is_open()) cout << "Hops written to " << hopsFile << "\n";
+    if (reachOut.is_open()) cout << "Reach sets written to " << reachFile << "\n";
+    return mismatches ? 1 : 0;
+}
+
+// ====================== MAIN ======================
+int main(int argc, char** argv) {
+    string nodesFile = "../dijkstra/nodes.csv", edgesFile = "../dijkstra/edges.csv";
+    string hopsFile, reachFile;
+    int sourceCount = 64, width = 64;
+    uint64_t seed = 42;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string a = argv[i];
+        if (a == "--nodes") nodesFile = argv[i + 1];
+        else if (a == "--edges") edgesFile = argv[i + 1];
+        else if (a == "--sources") sourceCount = max(1, stoi(argv[i + 1]));
+        else if (a == "--width") width = stoi(argv[i + 1]);
+        else if (a == "--hops") hopsFile = argv[i + 1];
+        else if (a == "--reach") reachFile = argv[i + 1];
+        else if (a == "--seed") seed = stoull(argv[i + 1]);
+    }
+    if (width != 64 && width != 256) {
+        cerr << "Error: --width must be 64 or 256" << endl;
+        return 1;
+    }
+
+    Graph g;
+    if (nodesFile != "-") load_nodes(g, nodesFile);
+    load_edges(g, edgesFile);
+    const int N = g.nodes.size();
+    Csr csr;
+    csr.build(g);
+
+    vector<int> valid;
+    for (int i = 0; i < N; ++i) if (g.adj.count(i)) valid.push_back(i);
+    if (valid.empty()) { cerr << "Error: graph has no edges" << endl; return 1; }
+    mt19937_64 rng(seed);
+    uniform_int_distribution<size_t> pick(0, valid.size() - 1);
+    vector<int> sources;
+    for (int i = 0; i < sourceCount; ++i) sources.push_back(valid[pick(rng)]);
+
+    cout << fixed << setprecision(3);
+    cout << "Graph: " << N << " node slots, " << csr.to.size() << " half-edges | " << sources.size()
+         << " sources, width " << width
+#if defined(__AVX2__)
+         << " (AVX2)"
+#endif
+         << "\n";
+    return width == 64 ? run<1>(g, csr, sources, hopsFile, reachFile)
+                       : run<4>(g, csr, sources, hopsFile, reachFile);
+}
@@ -1,174 +1,41 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <vector>
-#include <unordered_map>
-#include <unordered_set>
-#include <queue>
-#include <cmath>
-#include <string>
 #include <iomanip>
-#include <chrono>
-#include <functional>
-#include <algorithm>
-
-using namespace std;
-
-struct Node {
-    int id;
-    string name;
-    double x, y;
-    string cluster;
-};
-
-struct Edge {
-    int from, to;
-    double weight;
-};
-
-struct Graph {
-    vector<Node> nodes;
-    unordered_map<int, vector<pair<int,double>>> adj;
-};
-
-// ---------- Read CSV helpers ----------
-vector<Node> readNodes(const string& filename) {
-    vector<Node> nodes;
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "❌ Failed to open " << filename << endl;
-        exit(1);
-    }
-
-    string line;
-    getline(file, line); // skip header
-
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        stringstream ss(line);
-        string id, name, x, y, cluster;
-
-        getline(ss, id, ',');
-        getline(ss, name, ',');
-        getline(ss, x, ',');
-        getline(ss, y, ',');
-        getline(ss, cluster, ',');
-
-        try {
-            Node n;
-            n.id = stoi(id);
-            n.name = name;
-            n.x = stod(x);
-            n.y = stod(y);
-            n.cluster = cluster.empty() ? "None" : cluster;
-            nodes.push_back(n);
-        } catch (const invalid_argument&) {
-            cerr << "⚠️ Skipping invalid line: " << line << endl;
-        }
-    }
-    return nodes;
-}
-
-vector<Edge> readEdges(const string& filename) {
-    vector<Edge> edges;
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "❌ Failed to open " << filename << endl;
-        exit(1);
-    }
-    string line;
-    getline(file, line); // skip header
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        stringstream ss(line);
-        string from, to, weight;
-        getline(ss, from, ',');
-        getline(ss, to, ',');
-        getline(ss, weight, ',');
-
-        try {
-            edges.push_back({stoi(from), stoi(to), stod(weight)});
-        } catch (const invalid_argument&) {
-            cerr << "⚠️ Skipping invalid edge line: " << line << endl;
-        }
-    }
-    return edges;
-}
-
-// ---------- Heuristics ----------
-double euclideanHeuristic(const Node& a, const Node& b) {
-    double dx = a.x - b.x;
-    double dy = a.y - b.y;
-    return sqrt(dx*dx + dy*dy);
-}
-
-double clusterHeuristic(const Node& a, const Node& b) {
-    double base = euclideanHeuristic(a, b);
-    if (a.cluster == b.cluster)
-        return base;
-    else
-        return 1.5 * base; // overestimate for cross-cluster
-}
-
-// ---------- A* ----------
-pair<vector<int>, double> aStar(
-    const Graph& g, int start, int goal,
-    function<double(const Node&, const Node&)> heuristic,
-    int& expanded
-) {
-    unordered_map<int,double> gScore, fScore;
-    unordered_map<int,int> cameFrom;
-    for (auto& node : g.nodes) {
-        gScore[node.id] = 1e18;
-        fScore[node.id] = 1e18;
-    }
-    gScore[start] = 0;
-    fScore[start] = heuristic(g.nodes[start], g.nodes[goal]);
-
-    using P = pair<double,int>;
-    priority_queue<P, vector<P>, greater<P>> open;
-    open.push({fScore[start], start});
-
-    expanded = 0;
-    unordered_set<int> visited;
+#include <string>
+#include <vector>
 
-    while (!open.empty()) {
-        auto [f, u] = open.top();
-        open.pop();
-        if (visited.count(u)) continue;
-        visited.insert(u);
-        expanded++;
+#include "a_star_heuristics.h"
 
-        if (u == goal) break;
+using namespace std;
+using namespace part3;
 
-        for (auto [v, w] : g.adj.at(u)) {
-            double tentative = gScore[u] + w;
-            if (tentative < gScore[v]) {
-                cameFrom[v] = u;
-                gScore[v] = tentative;
-                fScore[v] = tentative + heuristic(g.nodes[v], g.nodes[goal]);
-                open.push({fScore[v], v});
-            }
+// ---------- MAIN ----------
+int main(int argc, char** argv) {
+    // --trace PREFIX writes PREFIX_euclidean.trace and PREFIX_cluster.trace
+    // --eps LIST runs the bounded-suboptimal engines for each epsilon (default 0.1,0.5,1)
+    // --log FILE appends one CSV row per bounded-suboptimal run
+    // --cells K grid side for the cluster index when nodes.csv has no clusters (default 3)
+    string tracePrefix, logFile;
+    int gridSide = 3;
+    vector<double> epsilons = {0.1, 0.5, 1.0};
+    for (int i = 1; i + 1 < argc; ++i) {
+        string a = argv[i];
+        if (a == "--trace") tracePrefix = argv[++i];
+        else if (a == "--log") logFile = argv[++i];
+        else if (a == "--cells") gridSide = stoi(argv[++i]);
+        else if (a == "--eps") {
+            epsilons.clear();
+            stringstream ss(argv[++i]);
+            for (string tok; getline(ss, tok, ',');)
+                if (!tok.empty()) epsilons.push_back(max(0.0, stod(tok)));
         }
     }
+    TraceRecorder trace1(tracePrefix.empty() ? 1 : 1 << 20), trace2(tracePrefix.empty() ? 1 : 1 << 20);
 
-    vector<int> path;
-    int cur = goal;
-    while (cameFrom.find(cur) != cameFrom.end()) {
-        path.push_back(cur);
-        cur = cameFrom[cur];
-    }
-    path.push_back(start);
-    reverse(path.begin(), path.end());
-    return {path, gScore[goal]};
-}
-
-// ---------- MAIN ----------
-int main() {
     string nodesFile = "nodes.csv";
     string edgesFile = "edges.csv";
 
-    auto nodes = readNodes(nodesFile);
+    vector<string> clusterNames;
+    auto nodes = readNodes(nodesFile, clusterNames);
     auto edges = readEdges(edgesFile);
 
     Graph g;
@@ -180,12 +47,14 @@ int main() {
     int expanded1, expanded2;
 
     auto startTime = chrono::high_resolution_clock::now();
-    auto [path1, cost1] = aStar(g, start, goal, euclideanHeuristic, expanded1);
+    auto [path1, cost1] = aStar(g, start, goal, euclideanHeuristic, expanded1,
+                                 tracePrefix.empty() ? nullptr : &trace1);
     auto endTime = chrono::high_resolution_clock::now();
     double time1 = chrono::duration<double, milli>(endTime - startTime).count();
 
     startTime = chrono::high_resolution_clock::now();
-    auto [path2, cost2] = aStar(g, start, goal, clusterHeuristic, expanded2);
+    auto [path2, cost2] = aStar(g, start, goal, clusterHeuristic, expanded2,
+                                 tracePrefix.empty() ? nullptr : &trace2);
     endTime = chrono::high_resolution_clock::now();
     double time2 = chrono::duration<double, milli>(endTime - startTime).count();
 
@@ -201,4 +70,81 @@ int main() {
     for (int p : path2) cout << g.nodes[p].name << " ";
     cout << "\nCost: " << cost2 << "\nNodes Expanded: " << expanded2
          << "\nRuntime: " << time2 << " ms\n";
+
+    // Bounded-suboptimal runs, measured against an optimal A* with the scaled heuristic.
+    double scale = admissibleScale(g);
+    auto scaledEuclidean = [scale](const Node& a, const Node& b) { return scale * euclideanHeuristic(a, b); };
+    int expandedOpt;
+    auto [pathOpt, costOpt] = aStar(g, start, goal, scaledEuclidean, expandedOpt);
+
+    cout << "\n=== Bounded-suboptimal (scaled Euclidean, scale " << setprecision(6) << scale << setprecision(3) << ") ===\n";
+    cout << "Optimal cost: " << costOpt << " | Nodes Expanded: " << expandedOpt << "\n";
+    cout << left << setw(12) << "engine" << right << setw(8) << "eps" << setw(10) << "cost"
+         << setw(10) << "ratio" << setw(10) << "expanded" << setw(12) << "ms" << "  bound\n";
+    ofstream log;
+    if (!logFile.empty()) {
+        bool fresh = !ifstream(logFile).good();
+        log.open(logFile, ios::app);
+        if (fresh) log << "engine,epsilon,cost,optimal_cost,suboptimality,expanded,optimal_expanded,ms\n";
+    }
+    for (double eps : epsilons) {
+        for (string engine : {"weighted", "focal"}) {
+            int exp = 0;
+            auto t0 = chrono::high_resolution_clock::now();
+            auto [p, cost] = engine == "weighted" ? weightedAStar(g, start, goal, scaledEuclidean, eps, exp)
+                                                  : focalSearch(g, start, goal, scaledEuclidean, eps, exp);
+            double ms = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - t0).count();
+            double ratio = costOpt > 0 ? cost / costOpt : 1.0;
+            bool ok = cost <= (1.0 + eps) * costOpt + 1e-9;
+            cout << left << setw(12) << engine << right << setw(8) << eps << setw(10) << cost
+                 << setw(10) << ratio << setw(10) << exp << setw(12) << ms
+                 << (ok ? "  ✅" : "  ❌ exceeds 1+eps") << "\n";
+            if (log.is_open())
+                log << engine << "," << eps << "," << cost << "," << costOpt << "," << ratio << ","
+                    << exp << "," << expandedOpt << "," << ms << "\n";
+        }
+    }
+
+    // Cluster lower bounds and arc flags, checked against the scaled-Euclidean
+    // baseline on this query and on every reachable pair.
+    ClusterIndex ci = buildClusterIndex(g, clusterNames.size(), gridSide);
+    cout << "\n=== Cluster preprocessing (" << ci.cells << (ci.fromCsv ? " clusters from nodes.csv" : " grid cells")
+         << ", " << ci.buildMs << " ms) ===\n";
+    struct Mode { const char* name; bool table, flags; };
+    const Mode modes[] = {{"euclidean", false, false}, {"lower-bound", true, false},
+                          {"arc-flags", false, true}, {"both", true, true}};
+    // Every pair on small graphs, a fixed sample of 2000 pairs otherwise.
+    const int N = g.nodes.size();
+    vector<pair<int,int>> pairs;
+    if ((size_t)N * N <= 40000) {
+        for (int s = 0; s < N; ++s)
+            for (int t = 0; t < N; ++t) pairs.push_back({s, t});
+    } else {
+        mt19937 rng(42);
+        uniform_int_distribution<int> pick(0, N - 1);
+        for (int i = 0; i < 2000; ++i) pairs.push_back({pick(rng), pick(rng)});
+    }
+    vector<double> baseline(pairs.size());
+    cout << left << setw(14) << "mode" << right << setw(10) << "cost" << setw(10) << "expanded"
+         << setw(16) << "pairs exp" << setw(12) << "mismatches" << "  (" << pairs.size() << " pairs)\n";
+    for (const Mode& m : modes) {
+        int exp = 0;
+        auto [p, cost] = clusterAStar(g, ci, start, goal, scale, m.table, m.flags, exp);
+        size_t total = 0, mismatches = 0;
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            int e = 0;
+            double c = clusterAStar(g, ci, pairs[i].first, pairs[i].second, scale, m.table, m.flags, e).second;
+            total += e;
+            if (&m == modes) baseline[i] = c;
+            else if (fabs(c - baseline[i]) > 1e-9 * max(1.0, c)) mismatches++;
+        }
+        cout << left << setw(14) << m.name << right << setw(10) << cost << setw(10) << exp
+             << setw(16) << total << setw(12) << mismatches << "\n";
+    }
+
+    if (!tracePrefix.empty()) {
+        trace1.save(tracePrefix + "_euclidean.trace");
+        trace2.save(tracePrefix + "_cluster.trace");
+        cout << "\nTraces written to " << tracePrefix << "_{euclidean,cluster}.trace\n";
+    }
 }
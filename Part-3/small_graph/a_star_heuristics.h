@@ -0,0 +1,472 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <queue>
+#include <random>
+#include <set>
+#include <cmath>
+#include <string>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+
+#include "../../Part-2/common/search_trace.h"
+
+using namespace std;
+
+// Part-3 graph, heuristics and searches. Included by a_star_heuristics.cpp
+// and by the benchmark; the namespace keeps Node / Graph apart from Part-2's.
+namespace part3 {
+
+struct Node {
+    int id;
+    string name;
+    double x, y;
+    int cluster;        // index into the cluster name table
+};
+
+struct Edge {
+    int from, to;
+    double weight;
+};
+
+struct Graph {
+    vector<Node> nodes;
+    unordered_map<int, vector<pair<int,double>>> adj;
+};
+
+// ---------- Read CSV helpers ----------
+// Cluster labels repeat across many nodes, so each distinct label is stored
+// once in clusterNames and nodes carry its index; the heuristic then compares
+// ints instead of strings.
+inline vector<Node> readNodes(const string& filename, vector<string>& clusterNames) {
+    vector<Node> nodes;
+    unordered_map<string, int> clusterIds;
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "❌ Failed to open " << filename << endl;
+        exit(1);
+    }
+
+    string line;
+    getline(file, line); // skip header
+
+    while (getline(file, line)) {
+        if (line.empty()) continue;
+        stringstream ss(line);
+        string id, name, x, y, cluster;
+
+        getline(ss, id, ',');
+        getline(ss, name, ',');
+        getline(ss, x, ',');
+        getline(ss, y, ',');
+        getline(ss, cluster, ',');
+
+        try {
+            Node n;
+            n.id = stoi(id);
+            n.name = name;
+            n.x = stod(x);
+            n.y = stod(y);
+            if (cluster.empty()) cluster = "None";
+            auto [it, fresh] = clusterIds.try_emplace(cluster, (int)clusterNames.size());
+            if (fresh) clusterNames.push_back(cluster);
+            n.cluster = it->second;
+            nodes.push_back(n);
+        } catch (const invalid_argument&) {
+            cerr << "⚠️ Skipping invalid line: " << line << endl;
+        }
+    }
+    return nodes;
+}
+
+inline vector<Edge> readEdges(const string& filename) {
+    vector<Edge> edges;
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "❌ Failed to open " << filename << endl;
+        exit(1);
+    }
+    string line;
+    getline(file, line); // skip header
+    while (getline(file, line)) {
+        if (line.empty()) continue;
+        stringstream ss(line);
+        string from, to, weight;
+        getline(ss, from, ',');
+        getline(ss, to, ',');
+        getline(ss, weight, ',');
+
+        try {
+            edges.push_back({stoi(from), stoi(to), stod(weight)});
+        } catch (const invalid_argument&) {
+            cerr << "⚠️ Skipping invalid edge line: " << line << endl;
+        }
+    }
+    return edges;
+}
+
+// ---------- Heuristics ----------
+inline double euclideanHeuristic(const Node& a, const Node& b) {
+    double dx = a.x - b.x;
+    double dy = a.y - b.y;
+    return sqrt(dx*dx + dy*dy);
+}
+
+inline double clusterHeuristic(const Node& a, const Node& b) {
+    double base = euclideanHeuristic(a, b);
+    if (a.cluster == b.cluster)
+        return base;
+    else
+        return 1.5 * base; // overestimate for cross-cluster
+}
+
+// ---------- A* ----------
+inline pair<vector<int>, double> aStar(
+    const Graph& g, int start, int goal,
+    function<double(const Node&, const Node&)> heuristic,
+    int& expanded,
+    TraceRecorder* trace = nullptr,
+    size_t* maxOpen = nullptr      // largest OPEN size seen, for the benchmark
+) {
+    unordered_map<int,double> gScore, fScore;
+    unordered_map<int,int> cameFrom;
+    for (auto& node : g.nodes) {
+        gScore[node.id] = 1e18;
+        fScore[node.id] = 1e18;
+    }
+    gScore[start] = 0;
+    fScore[start] = heuristic(g.nodes[start], g.nodes[goal]);
+
+    using P = pair<double,int>;
+    priority_queue<P, vector<P>, greater<P>> open;
+    open.push({fScore[start], start});
+    if (trace) {
+        trace->begin(start, goal);
+        trace->record(TraceEvent::Push, start, -1, 0.0f, (float)fScore[start]);
+    }
+
+    expanded = 0;
+    unordered_set<int> visited;
+
+    while (!open.empty()) {
+        if (maxOpen) *maxOpen = max(*maxOpen, open.size());
+        auto [f, u] = open.top();
+        open.pop();
+        if (visited.count(u)) {
+            if (trace) trace->record(TraceEvent::Stale, u, -1, (float)gScore[u], (float)f);
+            continue;
+        }
+        visited.insert(u);
+        expanded++;
+        if (trace) {
+            auto p = cameFrom.find(u);
+            trace->record(TraceEvent::Expand, u, p == cameFrom.end() ? -1 : p->second,
+                          (float)gScore[u], (float)f);
+        }
+
+        if (u == goal) break;
+
+        auto out = g.adj.find(u);
+        if (out == g.adj.end()) continue;    // sink: edges.csv rows are one-way here
+        for (auto [v, w] : out->second) {
+            double tentative = gScore[u] + w;
+            if (tentative < gScore[v]) {
+                cameFrom[v] = u;
+                gScore[v] = tentative;
+                fScore[v] = tentative + heuristic(g.nodes[v], g.nodes[goal]);
+                open.push({fScore[v], v});
+                if (trace) trace->record(TraceEvent::Push, v, u, (float)tentative, (float)fScore[v]);
+            }
+        }
+    }
+
+    vector<int> path;
+    int cur = goal;
+    while (cameFrom.find(cur) != cameFrom.end()) {
+        path.push_back(cur);
+        cur = cameFrom[cur];
+    }
+    path.push_back(start);
+    reverse(path.begin(), path.end());
+    return {path, gScore[goal]};
+}
+
+// ---------- Bounded-suboptimal search ----------
+// Both engines below return a path whose cost is at most (1 + eps) times the
+// optimum, provided the heuristic is admissible. Raw Euclidean distance is
+// not admissible here (coordinates are pixels, weights are not), so it is
+// scaled by the smallest weight/length ratio over all edges; the scaled
+// estimate is also consistent, since h(u) - h(v) <= scale * |uv| <= w(u,v).
+inline double admissibleScale(const Graph& g) {
+    double scale = INFINITY;
+    for (auto& [u, es] : g.adj)
+        for (auto [v, w] : es) {
+            double len = euclideanHeuristic(g.nodes[u], g.nodes[v]);
+            if (len > 1e-9) scale = min(scale, w / len);
+        }
+    return isfinite(scale) ? scale : 0.0;
+}
+
+// Weighted A*: f = g + (1 + eps) * h. With a consistent h the bound holds
+// without re-expanding closed nodes, so this is aStar() with an inflated h.
+inline pair<vector<int>, double> weightedAStar(
+    const Graph& g, int start, int goal,
+    function<double(const Node&, const Node&)> heuristic,
+    double eps, int& expanded
+) {
+    double w = 1.0 + eps;
+    return aStar(g, start, goal,
+                 [&](const Node& a, const Node& b) { return w * heuristic(a, b); }, expanded);
+}
+
+// Focal search (A*-epsilon): OPEN is ordered by f = g + h; FOCAL holds the
+// open nodes with f <= (1 + eps) * min f and is ordered by h, i.e. the node
+// that looks closest to the goal among those still within the bound. The
+// goal is accepted when it is chosen from FOCAL, so its cost is at most
+// (1 + eps) * min f <= (1 + eps) * optimum.
+inline pair<vector<int>, double> focalSearch(
+    const Graph& g, int start, int goal,
+    function<double(const Node&, const Node&)> heuristic,
+    double eps, int& expanded
+) {
+    const int N = g.nodes.size();
+    const double w = 1.0 + eps;
+    vector<double> gScore(N, 1e18), fScore(N, 1e18), hScore(N, 0.0);
+    vector<int> cameFrom(N, -1);
+    vector<char> inOpen(N, 0), inFocal(N, 0);
+    for (int v = 0; v < N; ++v) hScore[v] = heuristic(g.nodes[v], g.nodes[goal]);
+
+    set<pair<double,int>> open, focal;   // (f, v) and (h, v)
+    // FOCAL holds exactly the OPEN entries with f <= bound, the largest
+    // w * min f seen so far.
+    double bound = w * hScore[start];
+    auto push = [&](int v) {
+        open.insert({fScore[v], v});
+        inOpen[v] = 1;
+        if (fScore[v] <= bound) { focal.insert({hScore[v], v}); inFocal[v] = 1; }
+    };
+    auto remove = [&](int v) {
+        open.erase({fScore[v], v});
+        inOpen[v] = 0;
+        if (inFocal[v]) { focal.erase({hScore[v], v}); inFocal[v] = 0; }
+    };
+
+    gScore[start] = 0;
+    fScore[start] = hScore[start];
+    push(start);
+    expanded = 0;
+
+    while (!open.empty()) {
+        // min f may have grown since the last expansion: admit only the
+        // entries between the old bound and the new one.
+        double fMin = open.begin()->first;
+        if (w * fMin > bound) {
+            for (auto it = open.upper_bound({bound, INT_MAX}); it != open.end() && it->first <= w * fMin; ++it) {
+                focal.insert({hScore[it->second], it->second});
+                inFocal[it->second] = 1;
+            }
+            bound = w * fMin;
+        }
+
+        int u = focal.begin()->second;
+        remove(u);
+        expanded++;
+        if (u == goal) break;
+
+        auto it = g.adj.find(u);
+        if (it == g.adj.end()) continue;
+        for (auto [v, wt] : it->second) {
+            double tentative = gScore[u] + wt;
+            if (tentative < gScore[v]) {
+                // Closed nodes are reopened: nodes leave OPEN out of f order,
+                // so a cheaper route to one may still turn up.
+                if (inOpen[v]) remove(v);
+                cameFrom[v] = u;
+                gScore[v] = tentative;
+                fScore[v] = tentative + hScore[v];
+                push(v);
+            }
+        }
+    }
+
+    if (gScore[goal] >= 1e18) return {{}, gScore[goal]};
+    vector<int> path;
+    for (int cur = goal; cur != -1; cur = cameFrom[cur]) path.push_back(cur);
+    reverse(path.begin(), path.end());
+    return {path, gScore[goal]};
+}
+
+// ---------- Cluster preprocessing ----------
+// Clusters partition the graph into cells. Two tables are precomputed:
+//  * lowerBound[a][b]: shortest distance from any node of cell a to any node
+//    of cell b. dist(v, t) can't be smaller, so it is an admissible estimate
+//    for v in a and t in b, and usually much tighter than straight-line
+//    distance once the cells are apart.
+//  * arc flags: bit b on an edge says it lies on some shortest path into
+//    cell b. A query toward cell b only relaxes edges with that bit set.
+// When nodes.csv has no cluster column every node lands in "None", so the
+// plane is cut into a side x side grid instead.
+struct ClusterIndex {
+    int cells = 0;
+    bool fromCsv = false;
+    vector<int> cellOf;                               // node -> cell
+    vector<double> lowerBound;                        // cells x cells
+    unordered_map<int, vector<uint64_t>> arcFlags;    // parallel to Graph::adj
+    double buildMs = 0.0;
+
+    double bound(int v, int t) const { return lowerBound[(size_t)cellOf[v] * cells + cellOf[t]]; }
+};
+
+// Dijkstra from a set of sources; reverse = true follows edges backwards.
+inline vector<double> multiSourceDijkstra(const Graph& g, const unordered_map<int, vector<pair<int,double>>>& adj,
+                                          const vector<int>& sources) {
+    vector<double> dist(g.nodes.size(), 1e18);
+    using P = pair<double,int>;
+    priority_queue<P, vector<P>, greater<P>> pq;
+    for (int s : sources) { dist[s] = 0; pq.push({0, s}); }
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (d > dist[u]) continue;
+        auto it = adj.find(u);
+        if (it == adj.end()) continue;
+        for (auto [v, w] : it->second)
+            if (d + w < dist[v]) { dist[v] = d + w; pq.push({dist[v], v}); }
+    }
+    return dist;
+}
+
+inline ClusterIndex buildClusterIndex(const Graph& g, size_t clusterCount, int gridSide) {
+    auto t0 = chrono::high_resolution_clock::now();
+    ClusterIndex ci;
+    const int N = g.nodes.size();
+    ci.cellOf.resize(N);
+    ci.fromCsv = clusterCount > 1 && clusterCount <= 64;
+    if (ci.fromCsv) {
+        ci.cells = clusterCount;
+        for (int v = 0; v < N; ++v) ci.cellOf[v] = g.nodes[v].cluster;
+    } else {
+        gridSide = max(1, min(gridSide, 8));          // flags are one 64-bit word per edge
+        double minX = 1e18, minY = 1e18, maxX = -1e18, maxY = -1e18;
+        for (auto& n : g.nodes) {
+            minX = min(minX, n.x); maxX = max(maxX, n.x);
+            minY = min(minY, n.y); maxY = max(maxY, n.y);
+        }
+        auto slot = [&](double v, double lo, double hi) {
+            return min(gridSide - 1, (int)((v - lo) / max(hi - lo, 1e-9) * gridSide));
+        };
+        ci.cells = gridSide * gridSide;
+        for (int v = 0; v < N; ++v)
+            ci.cellOf[v] = slot(g.nodes[v].y, minY, maxY) * gridSide + slot(g.nodes[v].x, minX, maxX);
+    }
+
+    vector<vector<int>> members(ci.cells);
+    for (int v = 0; v < N; ++v) members[ci.cellOf[v]].push_back(v);
+    unordered_map<int, vector<pair<int,double>>> reverseAdj;
+    for (auto& [u, es] : g.adj)
+        for (auto [v, w] : es) reverseAdj[v].push_back({u, w});
+
+    // Lower bounds: one multi-source search per cell.
+    ci.lowerBound.assign((size_t)ci.cells * ci.cells, 1e18);
+    for (int a = 0; a < ci.cells; ++a) {
+        if (members[a].empty()) continue;
+        auto dist = multiSourceDijkstra(g, g.adj, members[a]);
+        for (int v = 0; v < N; ++v) {
+            double& lb = ci.lowerBound[(size_t)a * ci.cells + ci.cellOf[v]];
+            lb = min(lb, dist[v]);
+        }
+    }
+
+    // Arc flags: edges inside a cell carry its bit; for every boundary node
+    // (one with an edge coming in from another cell) a backward search marks
+    // the edges of its shortest-path tree. Any shortest path into the cell
+    // enters through a boundary node, so every edge it uses is flagged.
+    for (auto& [u, es] : g.adj) {
+        auto& flags = ci.arcFlags[u];
+        flags.assign(es.size(), 0);
+        for (size_t i = 0; i < es.size(); ++i)
+            if (ci.cellOf[u] == ci.cellOf[es[i].first]) flags[i] |= 1ull << ci.cellOf[u];
+    }
+    vector<char> boundary(N, 0);
+    for (auto& [u, es] : g.adj)
+        for (auto [v, w] : es)
+            if (ci.cellOf[u] != ci.cellOf[v]) boundary[v] = 1;
+    for (int b = 0; b < N; ++b) {
+        if (!boundary[b]) continue;
+        uint64_t bit = 1ull << ci.cellOf[b];
+        auto dist = multiSourceDijkstra(g, reverseAdj, {b});
+        for (auto& [u, es] : g.adj) {
+            if (dist[u] >= 1e18) continue;
+            auto& flags = ci.arcFlags[u];
+            for (size_t i = 0; i < es.size(); ++i)
+                if (fabs(dist[u] - (es[i].second + dist[es[i].first])) <= 1e-9 * max(1.0, dist[u]))
+                    flags[i] |= bit;
+        }
+    }
+
+    ci.buildMs = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - t0).count();
+    return ci;
+}
+
+// A* over the cluster index. h = max(scaled Euclidean, cell lower bound),
+// both admissible. The table bound is not consistent, so closed nodes are
+// reopened when a cheaper route turns up; the result stays optimal.
+inline pair<vector<int>, double> clusterAStar(const Graph& g, const ClusterIndex& ci, int start, int goal,
+                                              double hScale, bool useTable, bool useFlags, int& expanded) {
+    const int N = g.nodes.size();
+    const uint64_t goalBit = 1ull << ci.cellOf[goal];
+    vector<double> gScore(N, 1e18);
+    vector<int> cameFrom(N, -1);
+    auto h = [&](int v) {
+        double e = hScale * euclideanHeuristic(g.nodes[v], g.nodes[goal]);
+        return useTable ? max(e, ci.bound(v, goal)) : e;
+    };
+
+    using P = pair<double,int>;
+    priority_queue<P, vector<P>, greater<P>> open;
+    gScore[start] = 0;
+    open.push({h(start), start});
+    expanded = 0;
+
+    while (!open.empty()) {
+        auto [f, u] = open.top();
+        open.pop();
+        if (f > gScore[u] + h(u) + 1e-9) continue;   // stale entry
+        expanded++;
+        if (u == goal) break;
+
+        auto it = g.adj.find(u);
+        if (it == g.adj.end()) continue;
+        const auto& flags = ci.arcFlags.at(u);
+        for (size_t i = 0; i < it->second.size(); ++i) {
+            if (useFlags && !(flags[i] & goalBit)) continue;
+            auto [v, w] = it->second[i];
+            double tentative = gScore[u] + w;
+            if (tentative < gScore[v]) {
+                double hv = h(v);
+                if (hv >= 1e18) continue;               // goal's cell unreachable from v's cell
+                gScore[v] = tentative;
+                cameFrom[v] = u;
+                open.push({tentative + hv, v});
+            }
+        }
+    }
+
+    if (gScore[goal] >= 1e18) return {{}, gScore[goal]};
+    vector<int> path;
+    for (int cur = goal; cur != -1; cur = cameFrom[cur]) path.push_back(cur);
+    reverse(path.begin(), path.end());
+    return {path, gScore[goal]};
+}
+
+}  // namespace part3
@@ -1,59 +1,153 @@
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
 #include <queue>
-#include <unordered_map>
 #include <vector>
 #include <cmath>
 #include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
 
-struct Node {
-    int r, c;
-    bool blocked = false;
-    std::vector<Node*> nbrs;
-};
-
-constexpr int ROWS = 20;
+constexpr int ROWS = 20;                       // built-in corridor layout
 constexpr int COLS = 30;
-constexpr int CELL = 32;
+int CELL = 32;                                 // pixels per cell; shrinks so loaded maps fit
 constexpr float MAX_SPEED = 120.f;
 constexpr float ARRIVE_RADIUS = 10.f;
+constexpr float PLAN_BUDGET_MS = 2.f;          // ARA* time per frame
+constexpr size_t PLAN_MAX_EXPANSIONS = 4000;   // ARA* expansions per frame
+constexpr float SQRT2 = 1.41421356f;
+
+// Moves 0-3 are N, S, W, E; 4-7 are NW, NE, SW, SE.
+constexpr int DR[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+constexpr int DC[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+// --- Bit-packed occupancy grid ---
+// One bit per cell (1 = blocked). Row r lives at word (r + 1) * stride and
+// column c at bit c + 1, so there is a blocked border on all four sides:
+// neighbour lookups never range-check, and the three cells around a column
+// come out of one shifted word. Cells are identified by r * cols + c.
+struct BitGrid {
+    int rows = 0, cols = 0;
+    size_t stride = 0;              // 64-bit words per padded row
+    std::vector<uint64_t> bits;
+
+    void reset(int r, int c, bool blockedFill) {
+        rows = r;
+        cols = c;
+        stride = (size_t(c) + 2 + 63) / 64;
+        bits.assign((size_t(r) + 2) * stride, ~0ull);
+        if (!blockedFill)
+            for (int i = 0; i < r; ++i)
+                for (int j = 0; j < c; ++j) set(i, j, false);
+    }
+
+    bool inside(int r, int c) const { return r >= 0 && r < rows && c >= 0 && c < cols; }
+
+    bool blocked(int r, int c) const {
+        size_t p = size_t(c) + 1;
+        return bits[(size_t(r) + 1) * stride + (p >> 6)] >> (p & 63) & 1;
+    }
+    bool blocked(int id) const { return blocked(id / cols, id % cols); }
+
+    void set(int r, int c, bool b) {
+        size_t p = size_t(c) + 1;
+        uint64_t& w = bits[(size_t(r) + 1) * stride + (p >> 6)];
+        uint64_t m = 1ull << (p & 63);
+        w = b ? (w | m) : (w & ~m);
+    }
+
+    // Blocked bits of columns c-1, c, c+1 in row r (bit 0 = c-1).
+    unsigned window(int r, int c) const {
+        size_t p = size_t(c);
+        const uint64_t* row = &bits[(size_t(r) + 1) * stride];
+        uint64_t w = row[p >> 6] >> (p & 63);
+        if ((p & 63) > 61) w |= row[(p >> 6) + 1] << (64 - (p & 63));
+        return unsigned(w & 7);
+    }
+
+    // Legal moves out of (r, c), one bit per move index. A diagonal needs
+    // both orthogonal cells it passes free, so paths never clip a wall corner.
+    unsigned moves(int r, int c) const {
+        unsigned up = ~window(r - 1, c) & 7, mid = ~window(r, c) & 7, down = ~window(r + 1, c) & 7;
+        unsigned n = up >> 1 & 1, s = down >> 1 & 1, w = mid & 1, e = mid >> 2 & 1;
+        return n | s << 1 | w << 2 | e << 3 |
+               (up & n & w) << 4 | (up >> 2 & n & e) << 5 |
+               (down & s & w) << 6 | (down >> 2 & s & e) << 7;
+    }
+};
+
+// MovingAI .map: "type", "height", "width" header lines, then "map" and one
+// text row per grid row; '.', 'G' and 'S' are passable.
+bool load_map(const std::string& file, BitGrid& grid) {
+    std::ifstream in(file);
+    if (!in) return false;
+    std::string key;
+    int h = -1, w = -1;
+    while (in >> key && key != "map") {
+        if (key == "height") in >> h;
+        else if (key == "width") in >> w;
+        else in >> key;
+    }
+    if (key != "map" || h <= 0 || w <= 0) return false;
+    grid.reset(h, w, true);
+    std::string line;
+    std::getline(in, line);
+    for (int r = 0; r < h && std::getline(in, line); ++r)
+        for (int c = 0; c < w && c < (int)line.size(); ++c)
+            if (line[c] == '.' || line[c] == 'G' || line[c] == 'S') grid.set(r, c, false);
+    return true;
+}
 
 // Euclidean heuristic for A*
-float heuristic(Node* a, Node* b) {
-    float dx = a->c - b->c, dy = a->r - b->r;
+float heuristic(const BitGrid& grid, int a, int b) {
+    float dx = a % grid.cols - b % grid.cols, dy = a / grid.cols - b / grid.cols;
     return std::sqrt(dx * dx + dy * dy);
 }
 
+// Length of a cell path; for adjacent cells heuristic() is the step cost.
+float pathLength(const BitGrid& grid, const std::vector<int>& p) {
+    float cost = 0.f;
+    for (size_t i = 1; i < p.size(); ++i) cost += heuristic(grid, p[i - 1], p[i]);
+    return cost;
+}
+
 // --- A* search ---
-std::vector<Node*> a_star(Node* start, Node* goal) {
-    std::unordered_map<Node*, Node*> came;
-    std::unordered_map<Node*, float> g, f;
-    auto cmp = [&](Node* a, Node* b) { return f[a] > f[b]; };
-    std::priority_queue<Node*, std::vector<Node*>, decltype(cmp)> open(cmp);
+std::vector<int> a_star(const BitGrid& grid, int start, int goal) {
+    const size_t N = size_t(grid.rows) * grid.cols;
+    std::vector<float> g(N, 1e30f);
+    std::vector<int> came(N, -1);
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
 
     g[start] = 0;
-    f[start] = heuristic(start, goal);
-    open.push(start);
+    open.push({heuristic(grid, start, goal), start});
 
     while (!open.empty()) {
-        Node* cur = open.top();
+        auto [f, cur] = open.top();
         open.pop();
         if (cur == goal) break;
+        if (f > g[cur] + heuristic(grid, cur, goal) + 1e-5f) continue;   // stale entry
 
-        for (auto* n : cur->nbrs) {
-            if (n->blocked) continue;
-            float tentative = g[cur] + heuristic(cur, n);
-            if (!g.count(n) || tentative < g[n]) {
+        int r = cur / grid.cols, c = cur % grid.cols;
+        for (unsigned m = grid.moves(r, c); m; m &= m - 1) {
+            int d = __builtin_ctz(m);
+            int n = cur + DR[d] * grid.cols + DC[d];
+            float tentative = g[cur] + (d < 4 ? 1.f : SQRT2);
+            if (tentative < g[n]) {
                 came[n] = cur;
                 g[n] = tentative;
-                f[n] = tentative + heuristic(n, goal);
-                open.push(n);
+                open.push({tentative + heuristic(grid, n, goal), n});
             }
         }
     }
 
-    std::vector<Node*> path;
-    if (!came.count(goal)) return path;
-    for (Node* cur = goal; cur; cur = came.count(cur) ? came[cur] : nullptr) {
+    std::vector<int> path;
+    if (came[goal] < 0) return path;
+    for (int cur = goal; cur >= 0; cur = came[cur]) {
         path.push_back(cur);
         if (cur == start) break;
     }
@@ -61,8 +155,167 @@ std::vector<Node*> a_star(Node* start, Node* goal) {
     return path;
 }
 
-sf::Vector2f toWorld(Node* n) {
-    return {n->c * CELL + CELL / 2.f, n->r * CELL + CELL / 2.f};
+// --- ARA* (anytime repairing A*) ---
+// The first pass searches with an inflated heuristic (key = g + eps * h),
+// which reaches the goal after few expansions. Later passes lower eps and
+// repair the same search instead of restarting: g-values and parents carry
+// over, nodes improved after being closed wait in INCONS and rejoin OPEN for
+// the next pass. Each published path costs at most eps times the optimum.
+// improve() stops at a deadline or expansion budget and resumes where it left
+// off on the next call, so a frame never waits for the optimal search.
+struct AraStar {
+    static constexpr float EPS_START = 3.f;
+    static constexpr float EPS_STEP  = 0.5f;
+    static constexpr float INF = 1e30f;
+
+    using Entry = std::pair<float, int>;
+    std::vector<Entry> open;       // min-heap on key, stale entries skipped
+    std::vector<float> g;
+    std::vector<int> came;
+    std::vector<char> inOpen, closed, incons;
+    // Per-cell state is cleared only where a search wrote it, so reset() and
+    // each eps step cost what the search touched, not rows * cols.
+    std::vector<int> touched;      // cells with finite g
+    std::vector<int> closedList;   // closed in the current pass
+    std::vector<int> inconsList;   // improved after closing in the current pass
+    const BitGrid* grid = nullptr;
+    int start = -1;
+    int goal = -1;
+    float eps = EPS_START;
+    float solutionEps = INF;       // eps of the last published path
+    std::vector<int> path;         // last published path
+    float pathCost = INF;          // its length; can be below g[goal] once came[] has improved
+    size_t expansions = 0;         // total over all passes
+    bool failed = false;
+
+    static bool cmp(const Entry& a, const Entry& b) { return a.first > b.first; }
+
+    float key(int n) const { return g[n] + eps * heuristic(*grid, n, goal); }
+
+    void push(int n) {
+        open.push_back({key(n), n});
+        std::push_heap(open.begin(), open.end(), cmp);
+    }
+
+    void reset(const BitGrid& map, int s, int t) {
+        const size_t N = size_t(map.rows) * map.cols;
+        // Scattered clears lose to a sequential fill once most cells were touched.
+        if (g.size() != N || touched.size() > N / 8) {
+            g.assign(N, INF);
+            came.assign(N, -1);
+            inOpen.assign(N, 0);
+            closed.assign(N, 0);
+            incons.assign(N, 0);
+        } else {
+            for (int n : touched) {
+                g[n] = INF;
+                came[n] = -1;
+                inOpen[n] = closed[n] = incons[n] = 0;
+            }
+        }
+        touched.clear();
+        closedList.clear();
+        inconsList.clear();
+        open.clear();
+        grid = &map;
+        start = s;
+        goal = t;
+        eps = EPS_START;
+        solutionEps = INF;
+        path.clear();
+        pathCost = INF;
+        expansions = 0;
+        failed = false;
+        g[start] = 0.f;
+        touched.push_back(start);
+        push(start);
+        inOpen[start] = 1;
+    }
+
+    bool done() const { return failed || (solutionEps <= 1.f); }
+
+    // Drops entries whose node was closed or re-keyed since they were pushed.
+    void dropStale() {
+        while (!open.empty()) {
+            int n = open.front().second;
+            if (inOpen[n] && open.front().first <= key(n) + 1e-5f) break;
+            std::pop_heap(open.begin(), open.end(), cmp);
+            open.pop_back();
+        }
+    }
+
+    // Runs passes until the budget is spent or eps reaches 1. Returns true
+    // if a new path was published.
+    bool improve(std::chrono::steady_clock::time_point deadline, size_t maxExpansions) {
+        bool published = false;
+        size_t budget = 0;
+        while (!done()) {
+            dropStale();
+            while (!open.empty() && g[goal] > open.front().first) {
+                if (budget >= maxExpansions ||
+                    ((budget & 15) == 0 && std::chrono::steady_clock::now() >= deadline))
+                    return published;
+                int cur = open.front().second;
+                std::pop_heap(open.begin(), open.end(), cmp);
+                open.pop_back();
+                inOpen[cur] = 0;
+                closed[cur] = 1;
+                closedList.push_back(cur);
+                ++budget;
+                ++expansions;
+                int r = cur / grid->cols, c = cur % grid->cols;
+                for (unsigned m = grid->moves(r, c); m; m &= m - 1) {
+                    int d = __builtin_ctz(m);
+                    int n = cur + DR[d] * grid->cols + DC[d];
+                    float tentative = g[cur] + (d < 4 ? 1.f : SQRT2);
+                    if (tentative < g[n]) {
+                        if (g[n] >= INF) touched.push_back(n);
+                        g[n] = tentative;
+                        came[n] = cur;
+                        if (closed[n]) {
+                            if (!incons[n]) { incons[n] = 1; inconsList.push_back(n); }
+                        } else {
+                            push(n);
+                            inOpen[n] = 1;
+                        }
+                    }
+                }
+                dropStale();
+            }
+            if (g[goal] >= INF) { failed = true; return published; }
+
+            // Pass complete: publish the path for this eps, then tighten.
+            path.clear();
+            for (int cur = goal; cur >= 0; cur = (cur == start) ? -1 : came[cur]) path.push_back(cur);
+            std::reverse(path.begin(), path.end());
+            pathCost = pathLength(*grid, path);
+            solutionEps = eps;
+            published = true;
+            if (eps <= 1.f) break;
+
+            // OPEN for the next pass is OPEN + INCONS, re-keyed with the new
+            // eps; the heap's live entries (one per inOpen cell) give OPEN.
+            eps = std::max(1.f, eps - EPS_STEP);
+            std::vector<int> next;
+            for (const Entry& e : open)
+                if (inOpen[e.second]) { inOpen[e.second] = 0; next.push_back(e.second); }
+            for (int n : inconsList) { incons[n] = 0; next.push_back(n); }
+            for (int n : closedList) closed[n] = 0;
+            inconsList.clear();
+            closedList.clear();
+            open.clear();
+            for (int n : next) {
+                inOpen[n] = 1;
+                open.push_back({key(n), n});
+            }
+            std::make_heap(open.begin(), open.end(), cmp);
+        }
+        return published;
+    }
+};
+
+sf::Vector2f toWorld(const BitGrid& grid, int n) {
+    return {n % grid.cols * CELL + CELL / 2.f, n / grid.cols * CELL + CELL / 2.f};
 }
 
 // --- Agent with seek/arrive ---
@@ -78,12 +331,24 @@ struct Agent {
         shape.setFillColor(sf::Color::Cyan);
     }
 
-    void setPath(const std::vector<Node*>& nodes) {
+    void setPath(const BitGrid& grid, const std::vector<int>& cells) {
         path.clear();
-        for (auto* n : nodes) path.push_back(toWorld(n));
+        for (int n : cells) path.push_back(toWorld(grid, n));
         target = 0;
     }
 
+    // Swaps in a refined path without walking back to its start: resume at
+    // the waypoint closest to where the agent is now.
+    void refinePath(const BitGrid& grid, const std::vector<int>& cells) {
+        setPath(grid, cells);
+        float best = 1e30f;
+        for (size_t i = 0; i < path.size(); ++i) {
+            sf::Vector2f d = path[i] - shape.getPosition();
+            float d2 = d.x * d.x + d.y * d.y;
+            if (d2 < best) { best = d2; target = i; }
+        }
+    }
+
     void update(float dt) {
         if (target >= path.size()) return;
         sf::Vector2f pos = shape.getPosition();
@@ -100,62 +365,107 @@ struct Agent {
     }
 };
 
-int main() {
+// Usage: pathfollow [file.map]
+// Without a map file the built-in 20x30 corridor layout is used. Build with
+// -DPATHFOLLOW_VERIFY to also print a full A* cost when ARA* converges.
+int main(int argc, char** argv) {
+    BitGrid grid;
+    std::string title = "Dynamic A* Path Following (Corridor Layout)";
+    if (argc > 1) {
+        if (!load_map(argv[1], grid)) {
+            std::cerr << "Error: cannot load map " << argv[1] << "\n";
+            return 1;
+        }
+        title = std::string("Dynamic A* Path Following (") + argv[1] + ")";
+        CELL = std::max(1, std::min({CELL, 1280 / grid.cols, 800 / grid.rows}));
+    } else {
+        grid.reset(ROWS, COLS, false);
+
+        // --- Indoor layout (three long vertical walls with gaps) ---
+        // Left wall
+        for (int r = 0; r < ROWS; ++r)
+            for (int c = 6; c < 8; ++c)
+                grid.set(r, c, !(r >= 7 && r < 10));     // middle gap
+
+        // Middle wall
+        for (int r = 0; r < ROWS; ++r)
+            for (int c = 14; c < 16; ++c)
+                grid.set(r, c, !(r >= 3 && r < 6));      // upper gap
+
+        // Right wall
+        for (int r = 0; r < ROWS; ++r)
+            for (int c = 22; c < 24; ++c)
+                grid.set(r, c, !(r >= 11 && r < 14));    // lower gap
+    }
+
     // ✅ SFML 3.x fix: pass Vector2u to VideoMode
     sf::RenderWindow window(
-        sf::VideoMode({static_cast<unsigned int>(COLS * CELL),
-                       static_cast<unsigned int>(ROWS * CELL)}),
-        "Dynamic A* Path Following (Corridor Layout)");
+        sf::VideoMode({static_cast<unsigned int>(grid.cols * CELL),
+                       static_cast<unsigned int>(grid.rows * CELL)}),
+        title);
     window.setFramerateLimit(60);
 
-    Node grid[ROWS][COLS];
-    for (int r = 0; r < ROWS; ++r)
-        for (int c = 0; c < COLS; ++c)
-            grid[r][c] = {r, c, false, {}};
-
-    // --- Indoor layout (three long vertical walls with gaps) ---
-    // Left wall
-    for (int r = 0; r < ROWS; ++r)
-        for (int c = 6; c < 8; ++c)
-            grid[r][c].blocked = true;
-    for (int c = 6; c < 8; ++c)
-        for (int r = 7; r < 10; ++r)
-            grid[r][c].blocked = false;  // middle gap
-
-    // Middle wall
-    for (int r = 0; r < ROWS; ++r)
-        for (int c = 14; c < 16; ++c)
-            grid[r][c].blocked = true;
-    for (int c = 14; c < 16; ++c)
-        for (int r = 3; r < 6; ++r)
-            grid[r][c].blocked = false;  // upper gap
-
-    // Right wall
-    for (int r = 0; r < ROWS; ++r)
-        for (int c = 22; c < 24; ++c)
-            grid[r][c].blocked = true;
-    for (int c = 22; c < 24; ++c)
-        for (int r = 11; r < 14; ++r)
-            grid[r][c].blocked = false;  // lower gap
-
-    // --- Create neighbor links ---
-    for (int r = 0; r < ROWS; ++r)
-        for (int c = 0; c < COLS; ++c)
-            for (int dr = -1; dr <= 1; ++dr)
-                for (int dc = -1; dc <= 1; ++dc) {
-                    if (dr == 0 && dc == 0) continue;
-                    int nr = r + dr, nc = c + dc;
-                    if (nr >= 0 && nr < ROWS && nc >= 0 && nc < COLS)
-                        grid[r][c].nbrs.push_back(&grid[nr][nc]);
-                }
+    // The map never changes, so it is drawn into one texture up front
+    // instead of one rectangle per cell per frame.
+    sf::Image mapImage({static_cast<unsigned int>(grid.cols * CELL),
+                        static_cast<unsigned int>(grid.rows * CELL)},
+                       sf::Color(240, 240, 240));
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < grid.cols; ++c) {
+            if (!grid.blocked(r, c)) continue;
+            int inner = CELL > 2 ? CELL - 1 : CELL;   // 1px gap between cells when there is room
+            for (int y = 0; y < inner; ++y)
+                for (int x = 0; x < inner; ++x)
+                    mapImage.setPixel({static_cast<unsigned int>(c * CELL + x),
+                                       static_cast<unsigned int>(r * CELL + y)},
+                                      sf::Color(0, 255, 0));  // green walls
+        }
+    sf::Texture mapTexture(mapImage);
+    sf::Sprite mapSprite(mapTexture);
 
     Agent agent;
-    Node* start = &grid[1][1];
-    agent.shape.setPosition(toWorld(start));
+    int start = -1;
+    for (int i = grid.cols + 1; i < grid.rows * grid.cols && start < 0; ++i)
+        if (!grid.blocked(i)) start = i;       // (1, 1) on the corridor layout
+    if (start < 0) start = 0;
+    agent.shape.setPosition(toWorld(grid, start));
 
-    Node* goal = &grid[ROWS - 2][COLS - 2];
-    std::vector<Node*> path;
+    int goal = (grid.rows - 2) * grid.cols + grid.cols - 2;
+    std::vector<int> path;
     std::vector<sf::CircleShape> crumbs;
+    AraStar planner;
+    bool planning = false;
+
+    // Spends one frame's budget on the planner and hands any better path to the agent.
+    auto plan = [&]() {
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(static_cast<long>(PLAN_BUDGET_MS * 1000));
+        bool first = planner.path.empty();
+        if (planner.improve(deadline, PLAN_MAX_EXPANSIONS)) {
+            path = planner.path;
+            if (first) agent.setPath(grid, path);
+            else agent.refinePath(grid, path);
+            std::ostringstream status;
+            status << std::fixed << std::setprecision(2) << title
+                   << " | ARA* eps " << planner.solutionEps << ", cost " << planner.pathCost
+                   << ", " << planner.expansions << " expansions";
+            window.setTitle(status.str());
+        }
+        if (planner.done()) {
+            planning = false;
+            if (planner.failed)
+                std::cout << "No path to (" << goal / grid.cols << ", " << goal % grid.cols << ")\n";
+            else {
+                std::cout << "ARA* converged: cost " << planner.pathCost << " after " << planner.expansions
+                          << " expansions";
+#ifdef PATHFOLLOW_VERIFY
+                // Full synchronous A* for comparison; stalls the frame on large maps.
+                std::cout << " (A*: " << pathLength(grid, a_star(grid, planner.start, goal)) << ")";
+#endif
+                std::cout << "\n";
+            }
+        }
+    };
 
     while (window.isOpen()) {
         while (auto e = window.pollEvent()) {
@@ -164,27 +474,27 @@ int main() {
             if (auto m = e->getIf<sf::Event::MouseButtonPressed>()) {
                 if (m->button == sf::Mouse::Button::Left) {
                     int c = m->position.x / CELL, r = m->position.y / CELL;
-                    if (r >= 0 && r < ROWS && c >= 0 && c < COLS && !grid[r][c].blocked) {
-                        goal = &grid[r][c];
+                    if (grid.inside(r, c) && !grid.blocked(r, c)) {
+                        goal = r * grid.cols + c;
 
-                        // ✅ Dynamic start quantization: A* starts from agent's *current position*
+                        // ✅ Dynamic start quantization: ARA* starts from agent's *current position*
                         int agentC = static_cast<int>(agent.shape.getPosition().x / CELL);
                         int agentR = static_cast<int>(agent.shape.getPosition().y / CELL);
-                        if (agentR >= 0 && agentR < ROWS && agentC >= 0 && agentC < COLS) {
-                            Node* currentNode = &grid[agentR][agentC];
-                            if (!currentNode->blocked)
-                                path = a_star(currentNode, goal);
-                            else
-                                path = a_star(start, goal); // fallback
+                        if (grid.inside(agentR, agentC)) {
+                            int currentCell = agentR * grid.cols + agentC;
+                            planner.reset(grid, grid.blocked(currentCell) ? start : currentCell, goal);
+                            planning = true;
+                            path.clear();
+                            agent.setPath(grid, path);
+                            plan();   // inflated first pass: a usable path this frame
                         }
-
-                        agent.setPath(path);
                         crumbs.clear();
                     }
                 }
             }
         }
 
+        if (planning) plan();   // refine toward optimal within the frame budget
         agent.update(1.f / 60.f);
 
         sf::CircleShape crumb(2.f);
@@ -196,23 +506,14 @@ int main() {
         window.clear(sf::Color(240, 240, 240));
 
         // Draw grid and obstacles
-        sf::RectangleShape cell({CELL - 1.f, CELL - 1.f});
-        for (int r = 0; r < ROWS; ++r)
-            for (int c = 0; c < COLS; ++c) {
-                cell.setPosition({(float)c * CELL, (float)r * CELL});
-                if (grid[r][c].blocked)
-                    cell.setFillColor(sf::Color(0, 255, 0));  // green walls
-                else
-                    cell.setFillColor(sf::Color(240, 240, 240));  // background
-                window.draw(cell);
-            }
+        window.draw(mapSprite);
 
-        // Draw A* path (red)
-        for (auto* n : path) {
+        // Draw current ARA* path (red)
+        for (int n : path) {
             sf::CircleShape dot(3.f);
             dot.setOrigin({1.5f, 1.5f});
             dot.setFillColor(sf::Color::Red);
-            dot.setPosition(toWorld(n));
+            dot.setPosition(toWorld(grid, n));
             window.draw(dot);
         }
 
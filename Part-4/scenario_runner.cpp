@@ -0,0 +1,339 @@
+// Runs MovingAI benchmark scenarios (.scen) on their maps (.map) and reports
+// time and expansions for every scenario, plus per-bucket and total summaries.
+//
+//   scenario_runner <file.scen> [--map-dir DIR] [--limit N] [--csv FILE]
+//
+// Maps load into a bit-packed occupancy grid (one bit per cell), so an
+// 8k x 8k map is 8 MB of obstacles. Search follows the benchmark rules:
+// 8-connected, diagonal moves cost sqrt(2) and may not cut corners, '.', 'G'
+// and 'S' are passable. Each result is checked against the scenario's
+// optimal length.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+constexpr float SQRT2 = 1.41421356f;
+constexpr float INF = 1e30f;
+
+// Moves 0-3 are N, S, W, E; 4-7 are NW, NE, SW, SE.
+constexpr int DR[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+constexpr int DC[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+// --- Bit-packed occupancy grid ---
+// Row r lives at word (r + 1) * stride and column c at bit c + 1, so there is
+// a blocked border on all four sides: neighbour lookups never range-check,
+// and the three cells around a column come out of one shifted word.
+struct BitGrid {
+    int rows = 0, cols = 0;
+    size_t stride = 0;              // 64-bit words per padded row
+    std::vector<uint64_t> bits;     // 1 = blocked
+
+    void reset(int r, int c) {
+        rows = r;
+        cols = c;
+        stride = (size_t(c) + 2 + 63) / 64;
+        bits.assign((size_t(r) + 2) * stride, ~0ull);   // all blocked, border included
+    }
+
+    bool inside(int r, int c) const { return r >= 0 && r < rows && c >= 0 && c < cols; }
+
+    bool blocked(int r, int c) const {
+        size_t p = size_t(c) + 1;
+        return bits[(size_t(r) + 1) * stride + (p >> 6)] >> (p & 63) & 1;
+    }
+
+    void set(int r, int c, bool b) {
+        size_t p = size_t(c) + 1;
+        uint64_t& w = bits[(size_t(r) + 1) * stride + (p >> 6)];
+        uint64_t m = 1ull << (p & 63);
+        w = b ? (w | m) : (w & ~m);
+    }
+
+    // Blocked bits of columns c-1, c, c+1 in row r (bit 0 = c-1). r may be -1
+    // or rows, which reads the border.
+    unsigned window(int r, int c) const {
+        size_t p = size_t(c);   // bit index of column c-1
+        const uint64_t* row = &bits[(size_t(r) + 1) * stride];
+        uint64_t w = row[p >> 6] >> (p & 63);
+        if ((p & 63) > 61) w |= row[(p >> 6) + 1] << (64 - (p & 63));
+        return unsigned(w & 7);
+    }
+
+    // Legal moves out of (r, c), one bit per move index. A diagonal needs
+    // both orthogonal cells it passes free.
+    unsigned moves(int r, int c) const {
+        unsigned up = ~window(r - 1, c) & 7, mid = ~window(r, c) & 7, down = ~window(r + 1, c) & 7;
+        unsigned n = up >> 1 & 1, s = down >> 1 & 1, w = mid & 1, e = mid >> 2 & 1;
+        return n | s << 1 | w << 2 | e << 3 |
+               (up & n & w) << 4 | (up >> 2 & n & e) << 5 |
+               (down & s & w) << 6 | (down >> 2 & s & e) << 7;
+    }
+
+    size_t freeCells() const {
+        size_t blockedBits = 0;
+        for (uint64_t w : bits) blockedBits += __builtin_popcountll(w);
+        return bits.size() * 64 - blockedBits;
+    }
+};
+
+bool passable(char ch) { return ch == '.' || ch == 'G' || ch == 'S'; }
+
+// MovingAI .map: "type", "height", "width" header lines, then "map" and one
+// text row per grid row.
+bool load_map(const std::string& file, BitGrid& grid) {
+    std::ifstream in(file);
+    if (!in) return false;
+    std::string key;
+    int h = -1, w = -1;
+    while (in >> key && key != "map") {
+        if (key == "height") in >> h;
+        else if (key == "width") in >> w;
+        else in >> key;   // "type octile"
+    }
+    if (key != "map" || h <= 0 || w <= 0) return false;
+    grid.reset(h, w);
+    std::string line;
+    std::getline(in, line);
+    for (int r = 0; r < h && std::getline(in, line); ++r)
+        for (int c = 0; c < w && c < (int)line.size(); ++c)
+            if (passable(line[c])) grid.set(r, c, false);
+    return true;
+}
+
+// --- Scenarios ---
+struct Scenario {
+    int bucket;
+    std::string map;
+    int width, height;
+    int sx, sy, gx, gy;   // x = column, y = row
+    double optimal;
+};
+
+bool load_scen(const std::string& file, std::vector<Scenario>& out) {
+    std::ifstream in(file);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line.rfind("version", 0) == 0) continue;
+        std::istringstream ss(line);
+        Scenario s;
+        if (ss >> s.bucket >> s.map >> s.width >> s.height >> s.sx >> s.sy >> s.gx >> s.gy >> s.optimal)
+            out.push_back(s);
+    }
+    return true;
+}
+
+// --- Octile A* ---
+// Per-cell state is a float g-value plus one byte holding the parent move
+// and open/closed flags: 5 bytes a cell, 320 MB for 8k x 8k, allocated once
+// per map. Only the cells a search touched are reset before the next one.
+struct GridSearch {
+    static constexpr uint8_t NO_PARENT = 0x0f;
+    static constexpr uint8_t CLOSED    = 0x10;
+
+    const BitGrid* grid = nullptr;
+    std::vector<float> g;
+    std::vector<uint8_t> state;   // low nibble: move that reached the cell
+    std::vector<int> touched;
+    using Entry = std::pair<float, int>;
+    std::vector<Entry> heap;      // min-heap on f, stale entries skipped
+    size_t expansions = 0;
+
+    void attach(const BitGrid& gr) {
+        grid = &gr;
+        size_t n = size_t(gr.rows) * gr.cols;
+        g.assign(n, INF);
+        state.assign(n, NO_PARENT);
+        touched.clear();
+    }
+
+    float octile(int r, int c, int gr, int gc) const {
+        int dr = std::abs(r - gr), dc = std::abs(c - gc);
+        return float(std::max(dr, dc) - std::min(dr, dc)) + SQRT2 * std::min(dr, dc);
+    }
+
+    // Returns the optimal path length, or -1 if the goal is unreachable. The
+    // length is recomputed from the move counts in double precision.
+    double run(int sr, int sc, int gr, int gc, std::vector<int>* path = nullptr) {
+        for (int v : touched) { g[v] = INF; state[v] = NO_PARENT; }
+        touched.clear();
+        heap.clear();
+        expansions = 0;
+        const BitGrid& grd = *grid;
+        if (grd.blocked(sr, sc) || grd.blocked(gr, gc)) return -1;
+
+        const int cols = grd.cols;
+        const int start = sr * cols + sc, goal = gr * cols + gc;
+        auto cmp = [](const Entry& a, const Entry& b) { return a.first > b.first; };
+        g[start] = 0.f;
+        touched.push_back(start);
+        heap.push_back({octile(sr, sc, gr, gc), start});
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), cmp);
+            int u = heap.back().second;
+            heap.pop_back();
+            if (state[u] & CLOSED) continue;
+            state[u] |= CLOSED;
+            ++expansions;
+            if (u == goal) break;
+
+            int r = u / cols, c = u - r * cols;
+            unsigned m = grd.moves(r, c);
+            while (m) {
+                int d = __builtin_ctz(m);
+                m &= m - 1;
+                int v = u + DR[d] * cols + DC[d];
+                if (state[v] & CLOSED) continue;   // octile is consistent: closed is final
+                float tentative = g[u] + (d < 4 ? 1.f : SQRT2);
+                if (tentative >= g[v]) continue;
+                if (g[v] == INF) touched.push_back(v);
+                g[v] = tentative;
+                state[v] = uint8_t(d);
+                heap.push_back({tentative + octile(r + DR[d], c + DC[d], gr, gc), v});
+                std::push_heap(heap.begin(), heap.end(), cmp);
+            }
+        }
+        if (!(state[goal] & CLOSED)) return -1;
+
+        size_t straight = 0, diagonal = 0;
+        if (path) path->clear();
+        for (int v = goal; v != start;) {
+            if (path) path->push_back(v);
+            int d = state[v] & 0x0f;
+            (d < 4 ? straight : diagonal)++;
+            v -= DR[d] * cols + DC[d];
+        }
+        if (path) {
+            path->push_back(start);
+            std::reverse(path->begin(), path->end());
+        }
+        return double(straight) + double(diagonal) * std::sqrt(2.0);
+    }
+};
+
+// --- Runner ---
+std::string resolve_map(const std::string& name, const std::string& scenFile, const std::string& mapDir) {
+    auto base = [](const std::string& p) {
+        size_t k = p.find_last_of('/');
+        return k == std::string::npos ? p : p.substr(k + 1);
+    };
+    auto dir = [](const std::string& p) {
+        size_t k = p.find_last_of('/');
+        return k == std::string::npos ? std::string() : p.substr(0, k + 1);
+    };
+    std::vector<std::string> tries;
+    if (!mapDir.empty()) tries.push_back(mapDir + "/" + base(name));
+    tries.push_back(name);
+    tries.push_back(dir(scenFile) + base(name));
+    for (const auto& t : tries)
+        if (std::ifstream(t)) return t;
+    return name;
+}
+
+struct BucketSummary { size_t count = 0, expansions = 0; double us = 0.0, maxUs = 0.0; };
+
+int main(int argc, char** argv) {
+    std::string scenFile, mapDir, csvFile;
+    size_t limit = SIZE_MAX;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--map-dir" && i + 1 < argc) mapDir = argv[++i];
+        else if (a == "--limit" && i + 1 < argc) limit = std::stoul(argv[++i]);
+        else if (a == "--csv" && i + 1 < argc) csvFile = argv[++i];
+        else if (scenFile.empty() && a.rfind("--", 0) != 0) scenFile = a;
+        else { std::cerr << "Unknown argument: " << a << "\n"; return 1; }
+    }
+    if (scenFile.empty()) {
+        std::cerr << "Usage: scenario_runner <file.scen> [--map-dir DIR] [--limit N] [--csv FILE]\n";
+        return 1;
+    }
+
+    std::vector<Scenario> scens;
+    if (!load_scen(scenFile, scens)) { std::cerr << "Error: cannot open " << scenFile << "\n"; return 1; }
+    if (scens.size() > limit) scens.resize(limit);
+
+    std::ofstream csv;
+    if (!csvFile.empty()) {
+        csv.open(csvFile);
+        if (!csv) { std::cerr << "Error: cannot write " << csvFile << "\n"; return 1; }
+        csv << "bucket,map,sx,sy,gx,gy,optimal,length,expansions,us\n";
+    }
+
+    BitGrid grid;
+    GridSearch search;
+    std::string loadedMap;
+    std::map<int, BucketSummary> buckets;
+    size_t mismatches = 0;
+    std::cout << std::fixed;
+
+    for (const auto& s : scens) {
+        if (s.map != loadedMap) {
+            std::string path = resolve_map(s.map, scenFile, mapDir);
+            auto t0 = std::chrono::steady_clock::now();
+            if (!load_map(path, grid)) { std::cerr << "Error: cannot load map " << path << "\n"; return 1; }
+            search.attach(grid);
+            double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            loadedMap = s.map;
+            std::cout << "Map " << path << ": " << grid.cols << " x " << grid.rows << ", "
+                      << grid.freeCells() << " free cells | bit grid "
+                      << std::setprecision(2) << grid.bits.size() * 8 / 1048576.0 << " MB, search state "
+                      << (search.g.size() * 5) / 1048576.0 << " MB | loaded in "
+                      << std::setprecision(1) << loadMs << " ms\n";
+            std::cout << "bucket  start -> goal                  optimal      length  expansions        us\n";
+        }
+        if (s.width != grid.cols || s.height != grid.rows || !grid.inside(s.sy, s.sx) || !grid.inside(s.gy, s.gx)) {
+            std::cerr << "Skipping scenario outside " << s.map << ": (" << s.sx << "," << s.sy << ") -> ("
+                      << s.gx << "," << s.gy << ")\n";
+            continue;
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        double len = search.run(s.sy, s.sx, s.gy, s.gx);
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+        bool ok = std::fabs(len - s.optimal) <= 1e-4 * std::max(1.0, s.optimal);
+        if (!ok) ++mismatches;
+        auto& b = buckets[s.bucket];
+        b.count++;
+        b.expansions += search.expansions;
+        b.us += us;
+        b.maxUs = std::max(b.maxUs, us);
+
+        std::ostringstream route;
+        route << "(" << s.sx << "," << s.sy << ") -> (" << s.gx << "," << s.gy << ")";
+        std::cout << std::setw(6) << s.bucket << "  " << std::left << std::setw(26) << route.str() << std::right
+                  << std::setprecision(3) << std::setw(12) << s.optimal << std::setw(12) << len
+                  << std::setw(12) << search.expansions << std::setprecision(1) << std::setw(10) << us
+                  << (ok ? "" : "  MISMATCH") << "\n";
+        if (csv)
+            csv << s.bucket << "," << s.map << "," << s.sx << "," << s.sy << "," << s.gx << "," << s.gy << ","
+                << std::setprecision(6) << s.optimal << "," << len << "," << search.expansions << ","
+                << std::setprecision(1) << us << "\n";
+    }
+
+    BucketSummary total;
+    std::cout << "\nbucket  scenarios  mean expansions   mean us    max us\n";
+    for (const auto& [id, b] : buckets) {
+        std::cout << std::setw(6) << id << std::setw(11) << b.count << std::setprecision(1)
+                  << std::setw(17) << double(b.expansions) / b.count << std::setw(10) << b.us / b.count
+                  << std::setw(10) << b.maxUs << "\n";
+        total.count += b.count;
+        total.expansions += b.expansions;
+        total.us += b.us;
+        total.maxUs = std::max(total.maxUs, b.maxUs);
+    }
+    if (total.count)
+        std::cout << std::setprecision(1) << "Total: " << total.count << " scenarios, "
+                  << total.us / 1000.0 << " ms, mean " << total.us / total.count << " us, max "
+                  << total.maxUs << " us, " << mismatches << " off the optimal length\n";
+    return mismatches ? 2 : 0;
+}
@@ -0,0 +1,809 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../Part-2/a_star/a_star.h"
+#include "../Part-2/common/graph_cache.h"
+#include "../Part-2/dijkstra/dijkstra.h"
+#include "../Part-3/small_graph/a_star_heuristics.h"
+
+using namespace std;
+
+// Benchmark driver for the search engines in Part-2 (dijkstra, A* with file
+// heuristics) and Part-3 (Euclidean / cluster A*). The engines are the tools'
+// own code, included from their headers, including Part-2's reachability
+// filter; only loading is rewritten for multi-million-line inputs.
+//
+// Usage: benchmark [--queries N] [--reps N] [--warmup N] [--seed S]
+//                  [--campus DIR] [--sample FILE] [--roadnet FILE|DIR]
+//                  [--grid N[,N...]] [--engines a,b,...] [--out FILE]
+//                  [--reorder bfs|rcm|hilbert] [--cache DIR]
+//
+// --reorder also runs every dataset renumbered in that order (dataset name
+// suffixed "+order"). --cache DIR keeps loaded graphs and their reachability
+// index in Part-2's preprocessing cache. Build with -DSEARCH_PERF to add
+// cycles / cache misses; the Part-2 engines then read their own counters
+// inside the timed window, so take latencies from a plain build.
+//
+// Every engine reports its optimality gap against Dijkstra on the same
+// queries, and runs in a forked child so "engine_rss_kb" is the peak RSS that
+// engine added, not the process-wide high-water mark.
+// When astar_file is selected each dataset also reports "trace_overhead": the
+// A* engine timed with and without Part-2's trace ring.
+
+// ====================== Structures ======================
+struct Dataset {
+    string name;
+    Graph g;
+    part3::Graph g3;
+    vector<float> heur;                  // by node id; empty when the dataset has no heuristics file
+    int heurGoal = -1;                   // node the file heuristics point at
+    vector<int> cluster;                 // by node id, from nodes.csv's cluster column; else empty
+    size_t edgeRows = 0;
+    double loadMs = 0.0;
+};
+
+// ====================== Loaders ======================
+// fgets + strtol instead of stringstream: roadNet-CA has ~5.5M edge rows.
+static bool forEachRow(const string& file, bool skipHeader, const function<void(char*)>& fn) {
+    FILE* f = fopen(file.c_str(), "r");
+    if (!f) return false;
+    char line[1024];
+    bool first = true;
+    while (fgets(line, sizeof line, f)) {
+        if (first && skipHeader) { first = false; continue; }
+        first = false;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+        fn(line);
+    }
+    fclose(f);
+    return true;
+}
+
+static string trim(const string& s) {
+    size_t b = 0, e = s.size();
+    while (b < e && isspace((unsigned char)s[b])) ++b;
+    while (e > b && isspace((unsigned char)s[e - 1])) --e;
+    return s.substr(b, e - b);
+}
+
+// Edge lists without a nodes file (SNAP, sample_graph_edges.csv) have sparse
+// ids; only ids that occur in an edge become nodes, the rest stay unnamed gaps.
+static void ensureNodes(Dataset& d, const vector<char>& seen) {
+    if (d.g.nodes.size() < seen.size()) d.g.nodes.resize(seen.size());
+    for (int i = 0; i < (int)seen.size(); ++i)
+        if (seen[i] && d.g.nodes[i].name.empty())
+            d.g.addNode(i, "Node_" + to_string(i), 0.f, 0.f);
+}
+
+// addNodes = false reads only the cluster column, for graphs restored from
+// the cache.
+static bool loadNodesCsv(Dataset& d, const string& file, bool addNodes = true) {
+    unordered_map<string, int> clusterIds;
+    return forEachRow(file, true, [&](char* line) {
+        char* end;
+        long id = strtol(line, &end, 10);
+        if (end == line || *end != ',') return;
+        char* name = end + 1;
+        char* comma = strchr(name, ',');
+        if (!comma) return;
+        string nm = trim(string(name, comma));
+        float x = strtof(comma + 1, &end);
+        float y = 0.f;
+        if (*end == ',') y = strtof(end + 1, &end);
+        if (addNodes) d.g.addNode((int)id, nm, x, y);
+        if (*end != ',') return;
+        string cl = trim(string(end + 1));
+        if (cl.empty()) cl = "None";                 // Part-3 readNodes() does the same
+        auto [it, fresh] = clusterIds.try_emplace(cl, (int)clusterIds.size());
+        if ((long)d.cluster.size() <= id) d.cluster.resize(id + 1, -1);
+        d.cluster[id] = it->second;
+    });
+}
+
+// from,to,weight[,directed] with header, or SNAP "u<TAB>v" without one.
+static bool loadEdgeList(Dataset& d, const string& file, bool snap) {
+    int maxNode = (int)d.g.nodes.size() - 1;
+    vector<tuple<int,int,float,bool>> rows;
+    mt19937 rng(12345);
+    bool ok = forEachRow(file, !snap, [&](char* line) {
+        char* end;
+        long u = strtol(line, &end, 10);
+        if (end == line) return;
+        char* p = end + (*end == ',' ? 1 : 0);
+        long v = strtol(p, &end, 10);
+        if (end == p) return;
+        float w;
+        bool directed = true;
+        if (snap) {
+            w = float(rng() % 20 + 1);            // same range build_large_graph uses
+        } else {
+            if (*end != ',') return;
+            w = strtof(end + 1, &end);
+            if (*end == ',') directed = strtol(end + 1, nullptr, 10) != 0;
+        }
+        maxNode = max({maxNode, (int)u, (int)v});
+        rows.emplace_back((int)u, (int)v, w, directed);
+    });
+    if (!ok) return false;
+    vector<char> seen(maxNode + 1, 0);
+    for (auto& [u, v, w, dir] : rows) seen[u] = seen[v] = 1;
+    ensureNodes(d, seen);
+    for (auto& [u, v, w, dir] : rows) d.g.addEdge(u, v, w, dir);
+    d.edgeRows = rows.size();
+    return true;
+}
+
+static void loadHeuristics(Dataset& d, const string& file) {
+    // The file heuristics estimate distance to a single node: the one scored 0.
+    float best = INFINITY;
+    vector<float> h(d.g.nodes.size(), 0.0f);
+    bool any = forEachRow(file, true, [&](char* line) {
+        char* comma = strchr(line, ',');
+        if (!comma) return;
+        int id = d.g.findId(trim(string(line, comma)));
+        if (id < 0) return;
+        h[id] = strtof(comma + 1, nullptr);
+        if (h[id] < best) { best = h[id]; d.heurGoal = id; }
+    });
+    if (any) d.heur = move(h);
+}
+
+// Part-3's own loader reads every row as one-way; here it gets the same
+// adjacency as the Part-2 engines so all four answer identical queries.
+// Clusters come from nodes.csv when it has the column; otherwise nodes are
+// split into a CLUSTER_GRID x CLUSTER_GRID grid over their bounding box, the
+// fallback Part-3's buildClusterIndex() uses.
+constexpr int CLUSTER_GRID = 3;
+
+static void buildPart3(Dataset& d) {
+    const int N = d.g.nodes.size();
+    vector<int> cluster(N, 0);
+    bool fromCsv = false;
+    for (int c : d.cluster) if (c > 0) { fromCsv = true; break; }
+    if (fromCsv) {
+        for (int i = 0; i < N && i < (int)d.cluster.size(); ++i) cluster[i] = d.cluster[i];
+    } else {
+        float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+        for (auto& n : d.g.nodes) {
+            if (n.name.empty()) continue;
+            minX = min(minX, n.x); maxX = max(maxX, n.x);
+            minY = min(minY, n.y); maxY = max(maxY, n.y);
+        }
+        auto slot = [&](float v, float lo, float hi) {
+            return min(CLUSTER_GRID - 1, (int)((v - lo) / max(hi - lo, 1e-9f) * CLUSTER_GRID));
+        };
+        for (int i = 0; i < N; ++i)
+            if (!d.g.nodes[i].name.empty())
+                cluster[i] = slot(d.g.nodes[i].y, minY, maxY) * CLUSTER_GRID + slot(d.g.nodes[i].x, minX, maxX);
+    }
+    d.g3.nodes.clear();
+    d.g3.adj.clear();
+    for (int i = 0; i < N; ++i) {
+        const Node& n = d.g.nodes[i];
+        d.g3.nodes.push_back({i, string(n.name), n.x, n.y, cluster[i]});
+    }
+    for (auto& [u, es] : d.g.adj)
+        for (auto& e : es) d.g3.adj[u].push_back({e.to, e.w});
+}
+
+static void makeGrid(Dataset& d, int side, uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> wdist(1, 20);
+    const float SPACING = 10.f;
+    for (int r = 0; r < side; ++r)
+        for (int c = 0; c < side; ++c)
+            d.g.addNode(r * side + c, "Node_" + to_string(r * side + c), c * SPACING, r * SPACING);
+    for (int r = 0; r < side; ++r)
+        for (int c = 0; c < side; ++c) {
+            int u = r * side + c;
+            if (c + 1 < side) { d.g.addEdge(u, u + 1, (float)wdist(rng), false); d.edgeRows++; }
+            if (r + 1 < side) { d.g.addEdge(u, u + side, (float)wdist(rng), false); d.edgeRows++; }
+        }
+}
+
+// ====================== Engines ======================
+// The searches are Part-2's dijkstra() / a_star() and Part-3's aStar(); these
+// adapters only copy each engine's stats into one record.
+struct RunStats {
+    size_t expansions = 0;
+    size_t maxFringe  = 0;
+    double cost       = INFINITY;
+    size_t stateBytes = 0;    // per-query search state, estimated from container sizes
+    HwCounters hw;
+};
+
+static void runDijkstra(const Graph& g, int start, int goal, RunStats& st) {
+    DijkstraStats s;
+    dijkstra(g, start, goal, s);
+    st.expansions = s.expansions;
+    st.maxFringe = s.maxFringe;
+    st.cost = s.pathCost;
+    st.hw = s.hw;
+    st.stateBytes = g.nodes.size() * (sizeof(float) + sizeof(int) + sizeof(char))
+                  + st.maxFringe * sizeof(pair<float,int>);
+}
+
+static void runAStarFile(const Graph& g, int start, int goal,
+                         const vector<float>& heur, RunStats& st, TraceRecorder* trace = nullptr) {
+    AStarStats s;
+    a_star(g, start, goal, heur, s, trace);
+    st.expansions = s.expansions;
+    st.maxFringe = s.maxFringe;
+    st.cost = s.pathCost;
+    st.hw = s.hw;
+    st.stateBytes = g.nodes.size() * (2 * sizeof(float) + sizeof(int) + sizeof(char))
+                  + st.maxFringe * sizeof(pair<float,int>);
+}
+
+static void runPart3(const part3::Graph& g, int start, int goal,
+                     double (*heuristic)(const part3::Node&, const part3::Node&), RunStats& st) {
+    int expanded = 0;
+    auto [path, cost] = part3::aStar(g, start, goal, heuristic, expanded, nullptr, &st.maxFringe);
+    st.expansions = expanded;
+    st.cost = cost >= 1e18 ? INFINITY : cost;
+    // aStar() keeps g / f for every node plus cameFrom / visited (about one
+    // entry per expansion) in hash maps; a hash node is ~ key + value + next
+    // pointer, plus one bucket slot.
+    const size_t hashEntry = 2 * sizeof(void*) + sizeof(int) + sizeof(double);
+    st.stateBytes = (g.nodes.size() * 2 + st.expansions * 2) * hashEntry + st.maxFringe * sizeof(pair<double,int>);
+}
+
+// ====================== Renumbering ======================
+// The orders build_large_graph --order writes, applied in memory so the
+// original and renumbered layouts are measured on the same queries in one run.
+// Each returns newId[oldId].
+static vector<int> bfsOrder(const Graph& g, bool rcm) {
+    const int N = g.nodes.size();
+    auto deg = [&](int v) {
+        auto it = g.adj.find(v);
+        return it == g.adj.end() ? 0 : (int)it->second.size();
+    };
+    vector<int> seeds(N);
+    for (int i = 0; i < N; ++i) seeds[i] = i;
+    if (rcm) stable_sort(seeds.begin(), seeds.end(), [&](int a, int b) { return deg(a) < deg(b); });
+
+    vector<int> order;
+    order.reserve(N);
+    vector<char> seen(N, 0);
+    vector<int> scratch;
+    for (int s : seeds) {
+        if (seen[s]) continue;
+        seen[s] = 1;
+        size_t head = order.size();
+        order.push_back(s);
+        while (head < order.size()) {
+            int u = order[head++];
+            scratch.clear();
+            auto it = g.adj.find(u);
+            if (it != g.adj.end()) for (auto& e : it->second) scratch.push_back(e.to);
+            if (rcm) sort(scratch.begin(), scratch.end(), [&](int a, int b) { return deg(a) < deg(b); });
+            for (int v : scratch)
+                if (!seen[v]) { seen[v] = 1; order.push_back(v); }
+        }
+    }
+    if (rcm) reverse(order.begin(), order.end());
+    vector<int> newId(N);
+    for (int i = 0; i < N; ++i) newId[order[i]] = i;
+    return newId;
+}
+
+static uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+    const uint32_t n = 1u << 16;
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) { x = n - 1 - x; y = n - 1 - y; }
+            swap(x, y);
+        }
+    }
+    return d;
+}
+
+static vector<int> hilbertOrder(const Graph& g) {
+    const int N = g.nodes.size();
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (auto& n : g.nodes) {
+        minX = min(minX, n.x); maxX = max(maxX, n.x);
+        minY = min(minY, n.y); maxY = max(maxY, n.y);
+    }
+    float span = max({maxX - minX, maxY - minY, 1e-6f});
+    vector<pair<uint64_t,int>> keyed(N);
+    for (int i = 0; i < N; ++i) {
+        auto q = [&](float v, float lo) { return (uint32_t)min(65535.f, (v - lo) / span * 65535.f); };
+        keyed[i] = {hilbertIndex(q(g.nodes[i].x, minX), q(g.nodes[i].y, minY)), i};
+    }
+    sort(keyed.begin(), keyed.end());
+    vector<int> newId(N);
+    for (int i = 0; i < N; ++i) newId[keyed[i].second] = i;
+    return newId;
+}
+
+// Rebuilds src under newId; adjacency lists are allocated in new-id order.
+static void renumber(const Dataset& src, Dataset& dst, const vector<int>& newId) {
+    const int N = src.g.nodes.size();
+    vector<int> oldId(N);
+    for (int i = 0; i < N; ++i) oldId[newId[i]] = i;
+    dst.g.nodes.resize(N);
+    for (int nu = 0; nu < N; ++nu) {
+        const Node& n = src.g.nodes[oldId[nu]];
+        if (!n.name.empty()) dst.g.addNode(nu, n.name, n.x, n.y);
+        auto it = src.g.adj.find(oldId[nu]);
+        if (it == src.g.adj.end()) continue;
+        auto& out = dst.g.adj[nu];
+        for (auto& e : it->second) out.push_back({newId[e.to], e.w, e.directed});
+    }
+    dst.heur.assign(src.heur.size(), 0.0f);
+    for (size_t i = 0; i < src.heur.size(); ++i) dst.heur[newId[i]] = src.heur[i];
+    dst.heurGoal = src.heurGoal < 0 ? -1 : newId[src.heurGoal];
+    dst.cluster.assign(src.cluster.size(), -1);
+    for (size_t i = 0; i < src.cluster.size(); ++i) dst.cluster[newId[i]] = src.cluster[i];
+    dst.edgeRows = src.edgeRows;
+    dst.loadMs = src.loadMs;
+    dst.g.reach.build(dst.g.adj, N);
+}
+
+// ====================== Measurement ======================
+// Hardware counters around each timed run come from Part-2's PerfScope when
+// built with -DSEARCH_PERF on Linux; otherwise the values stay -1.
+struct Summary { double median = 0, p99 = 0, mean = 0, min = 0, max = 0; };
+
+static Summary summarize(vector<double> v) {
+    Summary s;
+    if (v.empty()) return s;
+    sort(v.begin(), v.end());
+    auto pct = [&](double p) {                     // nearest-rank percentile
+        size_t rank = (size_t)ceil(p * v.size());
+        return v[min(v.size(), max<size_t>(rank, 1)) - 1];
+    };
+    s.median = pct(0.5);
+    s.p99 = pct(0.99);
+    s.min = v.front();
+    s.max = v.back();
+    for (double x : v) s.mean += x;
+    s.mean /= v.size();
+    return s;
+}
+
+static long peakRssKb() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024;   // bytes on macOS
+#else
+    return ru.ru_maxrss;          // kilobytes on Linux
+#endif
+}
+
+static size_t graphBytes(const Graph& g) {
+    size_t b = g.nodes.capacity() * sizeof(Node);
+    b += g.names.reserved + g.nameSlots.capacity() * sizeof(int32_t);
+    for (auto& [u, es] : g.adj) b += es.capacity() * sizeof(Edge) + sizeof(vector<Edge>) + 3 * sizeof(void*);
+    return b;
+}
+
+struct Options {
+    int queries = 200, reps = 5, warmup = 2;
+    uint64_t seed = 42;
+    string campus = "../Part-2/a_star";
+    string sample = "../Part-1/large_graph/sample_graph_edges.csv";
+    string roadnet;
+    vector<int> grids = {100, 300};
+    unordered_set<string> engines = {"dijkstra", "astar_file", "p3_euclidean", "p3_cluster"};
+    string out;
+    string reorder;
+    string cache;        // --cache DIR: Part-2 preprocessing cache for loaded graphs
+};
+
+// Loads through Part-2's preprocessing cache (--cache DIR), which also holds
+// the reachability index the Part-2 engines filter queries with; load only
+// runs on a miss. Without --cache it just loads and builds the index.
+static bool loadGraph(Dataset& d, const vector<string>& inputs, const Options& opt, const function<void()>& load) {
+    for (const auto& f : inputs) {
+        FILE* fp = fopen(f.c_str(), "r");
+        if (!fp) return false;
+        fclose(fp);
+    }
+    // one tag per dataset: saving a tag prunes that tag's other files
+    load_graph(d.g, inputs, "bench-" + d.name, opt.cache, [&](Graph&) { load(); });
+    if (d.edgeRows == 0) {                  // restored: undirected rows are stored both ways
+        size_t halves = 0;
+        for (auto& [u, es] : d.g.adj)
+            for (auto& e : es) halves += e.directed ? 2 : 1;
+        d.edgeRows = halves / 2;
+    }
+    return true;
+}
+
+static string jsonNum(double x) {
+    if (!isfinite(x)) return "null";
+    ostringstream os;
+    os << setprecision(6) << x;
+    return os.str();
+}
+
+static string jsonSummary(const Summary& s) {
+    return "{\"median\":" + jsonNum(s.median) + ",\"p99\":" + jsonNum(s.p99) + ",\"mean\":" + jsonNum(s.mean) +
+           ",\"min\":" + jsonNum(s.min) + ",\"max\":" + jsonNum(s.max) + "}";
+}
+
+// Name storage: the original per-node std::string plus unordered_map<string,int>
+// against the arena plus open-addressing index, both rebuilt from the same
+// names. Lookups resolve every name once; bytes are estimated from sizes.
+static string nameIndexJson(const Graph& g) {
+    vector<int> ids;
+    for (auto& n : g.nodes) if (!n.name.empty()) ids.push_back(n.id);
+    auto ms = [](chrono::steady_clock::time_point a, chrono::steady_clock::time_point b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+    size_t sink = 0;
+
+    auto t0 = chrono::steady_clock::now();
+    vector<string> legacyNames(g.nodes.size());
+    unordered_map<string, int> legacyIndex;
+    for (int id : ids) {
+        legacyNames[id] = string(g.nodes[id].name);
+        legacyIndex[legacyNames[id]] = id;
+    }
+    auto t1 = chrono::steady_clock::now();
+    for (int id : ids) sink += legacyIndex.find(legacyNames[id])->second;
+    auto t2 = chrono::steady_clock::now();
+    auto heapBytes = [](const string& str) { return str.capacity() > 15 ? str.capacity() + 1 : 0; };
+    size_t legacyBytes = legacyNames.capacity() * sizeof(string) + legacyIndex.bucket_count() * sizeof(void*);
+    for (auto& str : legacyNames) legacyBytes += heapBytes(str);
+    for (auto& [k, v] : legacyIndex)
+        legacyBytes += sizeof(pair<const string, int>) + sizeof(void*) + sizeof(size_t) + heapBytes(k);
+
+    auto t3 = chrono::steady_clock::now();
+    Graph a;
+    a.nodes.reserve(g.nodes.size());
+    for (int id : ids) a.addNode(id, g.nodes[id].name, 0.f, 0.f);
+    auto t4 = chrono::steady_clock::now();
+    for (int id : ids) sink += a.findId(g.nodes[id].name);
+    auto t5 = chrono::steady_clock::now();
+    size_t arenaBytes = a.nodes.capacity() * sizeof(string_view) + a.names.reserved +
+                        a.nameSlots.capacity() * sizeof(int32_t);
+
+    ostringstream js;
+    js << "{\"names\":" << ids.size() << ",\"name_bytes\":" << a.names.bytes
+       << ",\"legacy\":{\"build_ms\":" << jsonNum(ms(t0, t1)) << ",\"lookup_ms\":" << jsonNum(ms(t1, t2))
+       << ",\"bytes_est\":" << legacyBytes << "}"
+       << ",\"arena\":{\"build_ms\":" << jsonNum(ms(t3, t4)) << ",\"lookup_ms\":" << jsonNum(ms(t4, t5))
+       << ",\"bytes_est\":" << arenaBytes << "}"
+       << ",\"checksum\":" << sink << "}";
+    cerr << "  names: legacy " << legacyBytes / 1024 << " KiB, arena " << arenaBytes / 1024 << " KiB\n";
+    return js.str();
+}
+
+// Runs fn in a forked child and returns what it returns, so memory an engine
+// allocates (and the allocator keeps) is gone before the next one starts.
+// Falls back to running in-process when fork / pipe fail.
+static string isolated(const function<string()>& fn) {
+    int fds[2];
+    if (pipe(fds) != 0) return fn();
+    cerr.flush();
+    pid_t pid = fork();
+    if (pid < 0) { close(fds[0]); close(fds[1]); return fn(); }
+    if (pid == 0) {
+        close(fds[0]);
+        string out = fn();
+        for (size_t done = 0; done < out.size();) {
+            ssize_t n = write(fds[1], out.data() + done, out.size() - done);
+            if (n <= 0) _exit(1);
+            done += n;
+        }
+        _exit(0);
+    }
+    close(fds[1]);
+    string out;
+    char buf[4096];
+    for (ssize_t n; (n = read(fds[0], buf, sizeof buf)) > 0;) out.append(buf, n);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || out.empty()) {
+        cerr << "⚠️ Engine child failed; running in-process\n";
+        return fn();
+    }
+    return out;
+}
+
+// Dijkstra's cost for every query: the reference the other engines' gaps
+// are measured against.
+static vector<double> referenceCosts(const Dataset& d, const vector<pair<int,int>>& queries) {
+    vector<double> ref;
+    for (auto [s, t] : queries) {
+        RunStats st;
+        runDijkstra(d.g, s, t, st);
+        ref.push_back(st.cost);
+    }
+    return ref;
+}
+
+// Runs one engine over the dataset's query set and returns its JSON record.
+// Meant to run under isolated(): engine_rss_kb is the peak RSS growth of the
+// calling process while the engine runs.
+static string benchEngine(const Dataset& d, const string& engine, const vector<pair<int,int>>& queries,
+                          const vector<double>& ref, const Options& opt) {
+    auto run = [&](int s, int t, RunStats& st) {
+        if (engine == "dijkstra")          runDijkstra(d.g, s, t, st);
+        else if (engine == "astar_file")   runAStarFile(d.g, s, t, d.heur, st);
+        else if (engine == "p3_euclidean") runPart3(d.g3, s, t, part3::euclideanHeuristic, st);
+        else                               runPart3(d.g3, s, t, part3::clusterHeuristic, st);
+    };
+    // The Part-2 engines read their own counters around the search loop.
+    const bool outerPerf = engine == "p3_euclidean" || engine == "p3_cluster";
+
+    long rssBefore = peakRssKb();
+    vector<double> latency, expansions, cycles, cacheMisses, gapPct;
+    size_t maxFringe = 0, maxState = 0, found = 0, suboptimal = 0, disagree = 0;
+    double costSum = 0;
+    for (size_t q = 0; q < queries.size(); ++q) {
+        auto [s, t] = queries[q];
+        for (int w = 0; w < opt.warmup; ++w) { RunStats st; run(s, t, st); }
+        for (int r = 0; r < opt.reps; ++r) {
+            RunStats st;
+            HwCounters hw;
+            PerfScope perf(hw);
+            if (outerPerf) perf.start();
+            auto t0 = chrono::steady_clock::now();
+            run(s, t, st);
+            auto t1 = chrono::steady_clock::now();
+            perf.stop();
+            if (outerPerf) st.hw = hw;
+            latency.push_back(chrono::duration<double, milli>(t1 - t0).count());
+            if (st.hw.cycles >= 0) cycles.push_back((double)st.hw.cycles);
+            if (st.hw.cacheMisses >= 0) cacheMisses.push_back((double)st.hw.cacheMisses);
+            if (r != 0) continue;
+            expansions.push_back((double)st.expansions);
+            maxFringe = max(maxFringe, st.maxFringe);
+            maxState = max(maxState, st.stateBytes);
+            if (isfinite(st.cost)) { found++; costSum += st.cost; }
+            if (isfinite(st.cost) != isfinite(ref[q])) { disagree++; continue; }
+            if (!isfinite(st.cost)) continue;
+            double gap = ref[q] > 0 ? (st.cost / ref[q] - 1.0) * 100.0 : (st.cost > 0 ? INFINITY : 0.0);
+            gapPct.push_back(gap);
+            if (gap > 1e-4) suboptimal++;          // float vs double costs differ in the last bits
+        }
+    }
+    long rssGrowth = max(0L, peakRssKb() - rssBefore);
+
+    ostringstream js;
+    js << "{\"dataset\":\"" << d.name << "\",\"engine\":\"" << engine << "\""
+       << ",\"queries\":" << queries.size() << ",\"reps\":" << opt.reps << ",\"warmup\":" << opt.warmup
+       << ",\"latency_ms\":" << jsonSummary(summarize(latency))
+       << ",\"expansions\":" << jsonSummary(summarize(expansions))
+       << ",\"cycles\":" << (cycles.empty() ? "null" : jsonSummary(summarize(cycles)))
+       << ",\"cache_misses\":" << (cacheMisses.empty() ? "null" : jsonSummary(summarize(cacheMisses)))
+       << ",\"max_fringe\":" << maxFringe
+       << ",\"state_bytes_est\":" << maxState
+       << ",\"found\":" << found
+       << ",\"mean_cost\":" << jsonNum(found ? costSum / found : NAN)
+       << ",\"optimality_gap_pct\":" << jsonSummary(summarize(gapPct))
+       << ",\"suboptimal\":" << suboptimal
+       << ",\"found_mismatch\":" << disagree
+       << ",\"engine_rss_kb\":" << rssGrowth << "}";
+    cerr << "  " << setw(13) << left << engine << " median " << fixed << setprecision(4)
+         << summarize(latency).median << " ms, p99 " << summarize(latency).p99 << " ms, gap mean "
+         << setprecision(2) << summarize(gapPct).mean << "% max " << summarize(gapPct).max << "%, +"
+         << rssGrowth << " KiB RSS\n" << defaultfloat;
+    return js.str();
+}
+
+struct QuerySet { vector<pair<int,int>> pairs, filePairs; };
+
+// Cost of a_star --trace: the A* engine with and without a recorder on the
+// same queries, reps interleaved (alternating which goes first) so drift and
+// cache warmth hit both sides alike. Datasets without heuristics.csv run it
+// with h = 0 on the regular query set.
+static string traceOverheadJson(const Dataset& d, const vector<pair<int,int>>& queries, const Options& opt) {
+    static TraceRecorder trace(1 << 20);             // a_star's ring size
+    vector<double> plain, traced;
+    double plainSum = 0, tracedSum = 0;
+    uint64_t records = 0;
+    auto timeOne = [&](int s, int t, TraceRecorder* tr) {
+        RunStats st;
+        auto t0 = chrono::steady_clock::now();
+        runAStarFile(d.g, s, t, d.heur, st, tr);
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    };
+    for (auto [s, t] : queries) {
+        for (int w = 0; w < opt.warmup; ++w) { timeOne(s, t, nullptr); timeOne(s, t, &trace); }
+        for (int r = 0; r < opt.reps; ++r) {
+            double a, b;
+            if (r % 2 == 0) { a = timeOne(s, t, nullptr); b = timeOne(s, t, &trace); }
+            else            { b = timeOne(s, t, &trace); a = timeOne(s, t, nullptr); }
+            plain.push_back(a); traced.push_back(b);
+            plainSum += a; tracedSum += b;
+            records += trace.emitted;
+        }
+    }
+    double pct = plainSum > 0 ? (tracedSum / plainSum - 1.0) * 100.0 : NAN;
+    cerr << "  trace overhead (A*): " << fixed << setprecision(1) << pct << "% ("
+         << setprecision(4) << plainSum << " ms untraced, " << tracedSum << " ms traced)\n"
+         << defaultfloat;
+    ostringstream js;
+    js << "{\"queries\":" << queries.size() << ",\"records\":" << records
+       << ",\"untraced_ms\":" << jsonSummary(summarize(plain)) << ",\"traced_ms\":" << jsonSummary(summarize(traced))
+       << ",\"overhead_pct\":" << jsonNum(pct) << "}";
+    return js.str();
+}
+
+// Fixed query set: same seed, same dataset -> same pairs on every run.
+static QuerySet makeQueries(const Dataset& d, const Options& opt) {
+    vector<int> valid;
+    for (size_t i = 0; i < d.g.nodes.size(); ++i) if (!d.g.nodes[i].name.empty()) valid.push_back(i);
+    QuerySet q;
+    if (valid.empty()) return q;
+    mt19937_64 rng(opt.seed);
+    uniform_int_distribution<size_t> pick(0, valid.size() - 1);
+    for (int i = 0; i < opt.queries; ++i) q.pairs.push_back({valid[pick(rng)], valid[pick(rng)]});
+    // heuristics.csv only estimates distance to one node, so A*-file queries all end there.
+    if (d.heurGoal >= 0)
+        for (int i = 0; i < opt.queries; ++i) q.filePairs.push_back({valid[pick(rng)], d.heurGoal});
+    return q;
+}
+
+static string benchDataset(Dataset& d, const Options& opt, const QuerySet& q) {
+    buildPart3(d);
+    size_t valid = 0;
+    for (auto& n : d.g.nodes) if (!n.name.empty()) valid++;
+    const auto& queries = q.pairs;
+    const auto& fileQueries = q.filePairs;
+
+    cerr << "📊 " << d.name << ": " << valid << " nodes, " << d.edgeRows << " edge rows\n";
+    ostringstream js;
+    js << "{\"name\":\"" << d.name << "\",\"nodes\":" << valid << ",\"edge_rows\":" << d.edgeRows
+       << ",\"load_ms\":" << jsonNum(d.loadMs) << ",\"reach_ms\":" << jsonNum(d.g.reach.ms)
+       << ",\"graph_bytes_est\":" << graphBytes(d.g)
+       << ",\"name_index\":" << nameIndexJson(d.g);
+    if (opt.engines.count("astar_file"))
+        js << ",\"trace_overhead\":" << traceOverheadJson(d, fileQueries.empty() ? queries : fileQueries, opt);
+    js << ",\"results\":[";
+    bool first = true;
+    vector<double> ref = referenceCosts(d, queries), fileRef = referenceCosts(d, fileQueries);
+    for (const string e : {"dijkstra", "astar_file", "p3_euclidean", "p3_cluster"}) {
+        if (!opt.engines.count(e)) continue;
+        if (e == "astar_file" && fileQueries.empty()) continue;
+        bool file = e == "astar_file";
+        js << (first ? "" : ",")
+           << isolated([&] { return benchEngine(d, e, file ? fileQueries : queries, file ? fileRef : ref, opt); });
+        first = false;
+    }
+    js << "]}";
+    return js.str();
+}
+
+// ====================== MAIN ======================
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        auto next = [&]() -> string {
+            if (i + 1 >= argc) { cerr << "Missing value for " << a << endl; exit(1); }
+            return argv[++i];
+        };
+        if (a == "--queries")      opt.queries = stoi(next());
+        else if (a == "--reps")    opt.reps = stoi(next());
+        else if (a == "--warmup")  opt.warmup = stoi(next());
+        else if (a == "--seed")    opt.seed = stoull(next());
+        else if (a == "--campus")  opt.campus = next();
+        else if (a == "--sample")  opt.sample = next();
+        else if (a == "--roadnet") opt.roadnet = next();
+        else if (a == "--out")     opt.out = next();
+        else if (a == "--cache")   opt.cache = next();
+        else if (a == "--reorder") {
+            opt.reorder = next();
+            if (opt.reorder != "bfs" && opt.reorder != "rcm" && opt.reorder != "hilbert") {
+                cerr << "Unknown --reorder " << opt.reorder << " (bfs|rcm|hilbert)" << endl;
+                return 1;
+            }
+        }
+        else if (a == "--grid") {
+            opt.grids.clear();
+            stringstream ss(next());
+            for (string tok; getline(ss, tok, ',');) if (!tok.empty()) opt.grids.push_back(stoi(tok));
+        } else if (a == "--engines") {
+            opt.engines.clear();
+            stringstream ss(next());
+            for (string tok; getline(ss, tok, ',');) if (!tok.empty()) opt.engines.insert(tok);
+        } else {
+            cerr << "Unknown option " << a << endl;
+            return 1;
+        }
+    }
+
+    vector<string> records;
+    auto timed = [&](Dataset& d, const function<bool()>& load) {
+        auto t0 = chrono::steady_clock::now();
+        if (!load()) { cerr << "⚠️ Skipping " << d.name << " (input not found)\n"; return; }
+        d.loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        QuerySet q = makeQueries(d, opt);
+        records.push_back(benchDataset(d, opt, q));
+        if (opt.reorder.empty()) return;
+
+        vector<int> newId = opt.reorder == "hilbert" ? hilbertOrder(d.g) : bfsOrder(d.g, opt.reorder == "rcm");
+        Dataset r;
+        r.name = d.name + "+" + opt.reorder;
+        renumber(d, r, newId);
+        d = Dataset();                       // release the original before measuring the copy
+        for (auto& p : q.pairs) p = {newId[p.first], newId[p.second]};
+        for (auto& p : q.filePairs) p = {newId[p.first], newId[p.second]};
+        records.push_back(benchDataset(r, opt, q));
+    };
+
+    // nodes.csv + edges.csv (+ heuristics.csv) through the cache; a restored
+    // graph still needs nodes.csv's cluster column read.
+    auto loadCsvDir = [&](Dataset& d, const string& dir) {
+        string nodes = dir + "/nodes.csv", edges = dir + "/edges.csv";
+        bool ok = true;
+        if (!loadGraph(d, {nodes, edges}, opt, [&] {
+                ok = loadNodesCsv(d, nodes) && loadEdgeList(d, edges, false);
+            }) || !ok)
+            return false;
+        if (d.cluster.empty()) loadNodesCsv(d, nodes, false);
+        loadHeuristics(d, dir + "/heuristics.csv");
+        return true;
+    };
+    {
+        Dataset d; d.name = "campus";
+        timed(d, [&] { return loadCsvDir(d, opt.campus); });
+    }
+    {
+        Dataset d; d.name = "sample_graph_edges";
+        timed(d, [&] { return loadGraph(d, {opt.sample}, opt, [&] { loadEdgeList(d, opt.sample, false); }); });
+    }
+    if (!opt.roadnet.empty()) {
+        // Either the raw SNAP file or a directory holding build_large_graph's CSVs.
+        Dataset d; d.name = "roadNet-CA";
+        timed(d, [&] {
+            if (opt.roadnet.size() > 4 && opt.roadnet.substr(opt.roadnet.size() - 4) == ".txt")
+                return loadGraph(d, {opt.roadnet}, opt, [&] { loadEdgeList(d, opt.roadnet, true); });
+            return loadCsvDir(d, opt.roadnet);
+        });
+    }
+    for (int side : opt.grids) {
+        Dataset d; d.name = "grid_" + to_string(side) + "x" + to_string(side);
+        timed(d, [&] {
+            makeGrid(d, side, opt.seed);
+            d.g.reach.build(d.g.adj, d.g.nodes.size());
+            return true;
+        });
+    }
+
+    ostringstream js;
+    js << "{\"seed\":" << opt.seed << ",\"queries\":" << opt.queries << ",\"reps\":" << opt.reps
+       << ",\"warmup\":" << opt.warmup << ",\"peak_rss_kb\":" << peakRssKb() << ",\"datasets\":[";
+    for (size_t i = 0; i < records.size(); ++i) js << (i ? "," : "") << records[i];
+    js << "]}\n";
+
+    if (opt.out.empty()) {
+        cout << js.str();
+    } else {
+        ofstream(opt.out) << js.str();
+        cerr << "✅ Wrote " << opt.out << "\n";
+    }
+}